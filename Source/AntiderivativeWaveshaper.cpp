@@ -0,0 +1,283 @@
+/*
+  ==============================================================================
+
+    AntiderivativeWaveshaper.cpp
+    Created: 18 Oct 2026 3:41:18am
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#include "AntiderivativeWaveshaper.h"
+#include <iterator>
+
+template<typename SampleType>
+AntiderivativeWaveshaper<SampleType>::AntiderivativeWaveshaper() :
+	curve_(Curve::logistic),
+	scale_(1.0),
+	gain_(1.0),
+	order_(1)
+{
+	setCurve(Curve::logistic, 0.f);
+}
+
+template<typename SampleType>
+void AntiderivativeWaveshaper<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+{
+	states_.resize(spec.numChannels);
+
+	reset();
+}
+
+template<typename SampleType>
+void AntiderivativeWaveshaper<SampleType>::reset()
+{
+	for (auto& state : states_)
+		state = { 0.0, 0.0 };
+}
+
+template<typename SampleType>
+void AntiderivativeWaveshaper<SampleType>::setOrder(int order)
+{
+	jassert(order == 1 || order == 2);
+
+	if (order != order_)
+	{
+		order_ = order;
+		reset();
+	}
+}
+
+template<typename SampleType>
+int AntiderivativeWaveshaper<SampleType>::getOrder() const
+{
+	return order_;
+}
+
+template<typename SampleType>
+void AntiderivativeWaveshaper<SampleType>::setCurve(Curve curve, float saturation)
+{
+	// Saturation coefficient
+	const double k = 1.0 + 7.0 * saturation;
+
+	curve_ = curve;
+
+	switch (curve_)
+	{
+	case Curve::logistic:
+		// 2 / (1 + e^-x) - 1 is tanh(x / 2)
+		scale_ = k / 2.0;
+		gain_ = 1.0 / std::tanh(scale_);
+		break;
+	case Curve::atan:
+		scale_ = k;
+		gain_ = 1.0 / std::atan(scale_);
+		break;
+	case Curve::tanh:
+		scale_ = k;
+		gain_ = 1.0 / std::tanh(scale_);
+		break;
+	}
+}
+
+template<typename SampleType>
+void AntiderivativeWaveshaper<SampleType>::process(const juce::dsp::AudioBlock<SampleType>& block, SampleType mix)
+{
+	jassert(block.getNumChannels() <= states_.size());
+
+	if (order_ == 1)
+		processOrder<1>(block, static_cast<double>(mix));
+	else
+		processOrder<2>(block, static_cast<double>(mix));
+}
+
+template<typename SampleType>
+template<int Order>
+void AntiderivativeWaveshaper<SampleType>::processOrder(const juce::dsp::AudioBlock<SampleType>& block, double mix)
+{
+	const auto numSamples = block.getNumSamples();
+	const bool isShaping = mix > 0.0;
+
+	for (size_t ch = 0; ch < block.getNumChannels(); ch++)
+	{
+		auto* samples = block.getChannelPointer(ch);
+		auto [x1, x2] = states_[ch];
+
+		if constexpr (Order == 1)
+		{
+			// Carried over from the last block, the curve may have changed since
+			auto antiderivative1 = isShaping ? getAntiderivative1(x1) : 0.0;
+
+			for (size_t i = 0; i < numSamples; i++)
+			{
+				const auto x0 = static_cast<double>(samples[i]);
+				auto y = x0;
+
+				if (isShaping)
+				{
+					const auto nextAntiderivative1 = getAntiderivative1(x0);
+					const auto dx = x0 - x1;
+
+					const auto shaped = std::abs(dx) < tolerance ?
+						shape((x0 + x1) * 0.5) :
+						(nextAntiderivative1 - antiderivative1) / dx;
+
+					// Half a sample back, same as the shaped part
+					const auto dry = (x0 + x1) * 0.5;
+
+					y = dry + (shaped - dry) * mix;
+					antiderivative1 = nextAntiderivative1;
+				}
+
+				samples[i] = static_cast<SampleType>(y);
+				x1 = x0;
+			}
+		}
+		else
+		{
+			// Difference quotient of the second antiderivative between two samples
+			const auto getQuotient = [this](double a, double b, double antiderivativeA, double antiderivativeB)
+			{
+				const auto dx = a - b;
+
+				return std::abs(dx) < tolerance ?
+					getAntiderivative1((a + b) * 0.5) :
+					(antiderivativeA - antiderivativeB) / dx;
+			};
+
+			// Carried over from the last block, the curve may have changed since
+			auto antiderivative2 = 0.0;
+			auto quotient = 0.0;
+
+			if (isShaping)
+			{
+				antiderivative2 = getAntiderivative2(x1);
+				quotient = getQuotient(x1, x2, antiderivative2, getAntiderivative2(x2));
+			}
+
+			for (size_t i = 0; i < numSamples; i++)
+			{
+				const auto x0 = static_cast<double>(samples[i]);
+				auto y = x1;
+
+				if (isShaping)
+				{
+					const auto nextAntiderivative2 = getAntiderivative2(x0);
+					const auto nextQuotient = getQuotient(x0, x1, nextAntiderivative2, antiderivative2);
+					auto shaped = 0.0;
+
+					if (std::abs(x0 - x2) < tolerance)
+					{
+						// Back where it was two samples ago, around x1
+						const auto mean = (x0 + x2) * 0.5;
+						const auto delta = mean - x1;
+
+						shaped = std::abs(delta) < tolerance ?
+							shape((mean + x1) * 0.5) :
+							2.0 / delta * (getAntiderivative1(mean) + (antiderivative2 - getAntiderivative2(mean)) / delta);
+					}
+					else
+					{
+						shaped = 2.0 * (nextQuotient - quotient) / (x0 - x2);
+					}
+
+					y = x1 + (shaped - x1) * mix;
+					antiderivative2 = nextAntiderivative2;
+					quotient = nextQuotient;
+				}
+
+				samples[i] = static_cast<SampleType>(y);
+				x2 = x1;
+				x1 = x0;
+			}
+		}
+
+		states_[ch] = { x1, x2 };
+	}
+}
+
+template<typename SampleType>
+double AntiderivativeWaveshaper<SampleType>::shape(double x) const
+{
+	if (curve_ == Curve::atan)
+		return std::atan(scale_ * x) * gain_;
+
+	return std::tanh(scale_ * x) * gain_;
+}
+
+template<typename SampleType>
+double AntiderivativeWaveshaper<SampleType>::getAntiderivative1(double x) const
+{
+	const auto u = scale_ * x;
+
+	if (curve_ == Curve::atan)
+		return (x * std::atan(u) - std::log1p(u * u) / (2.0 * scale_)) * gain_;
+
+	return getLogCosh(u) / scale_ * gain_;
+}
+
+template<typename SampleType>
+double AntiderivativeWaveshaper<SampleType>::getAntiderivative2(double x) const
+{
+	const auto u = scale_ * x;
+	const auto k = scale_;
+
+	if (curve_ == Curve::atan)
+	{
+		const auto atanU = std::atan(u);
+		const auto logU = std::log1p(u * u);
+
+		return (((u * u + 1.0) * atanU - u) / (2.0 * k * k) - (x * logU - 2.0 * x + 2.0 * atanU / k) / (2.0 * k)) * gain_;
+	}
+
+	return getLogCoshIntegral(u) / (k * k) * gain_;
+}
+
+template<typename SampleType>
+double AntiderivativeWaveshaper<SampleType>::getLogCosh(double u)
+{
+	// Stays finite for large u, unlike cosh()
+	const auto a = std::abs(u);
+
+	return a + std::log1p(std::exp(-2.0 * a)) - ln2;
+}
+
+template<typename SampleType>
+double AntiderivativeWaveshaper<SampleType>::getLogCoshIntegral(double u)
+{
+	// Odd, zero at 0: u^2 / 2 - u ln2 + (Li2(-e^-2u) + pi^2 / 12) / 2 for u >= 0
+	const auto a = std::abs(u);
+	const auto pi = juce::MathConstants<double>::pi;
+
+	const auto integral = a * a * 0.5 - a * ln2 + (getDilogarithm(std::exp(-2.0 * a)) + pi * pi / 12.0) * 0.5;
+
+	return u < 0.0 ? -integral : integral;
+}
+
+template<typename SampleType>
+double AntiderivativeWaveshaper<SampleType>::getDilogarithm(double t)
+{
+	// Li2(-t) = -ln^2(1 + t) / 2 - Li2(t / (1 + t)), then the Bernoulli series of Li2 in L = -ln(1 - t / (1 + t)) = ln(1 + t),
+	// which is at most ln2 here, so that it converges fast.
+	static constexpr double bernoulli[] = {
+		1.0, -1.0 / 2.0, 1.0 / 6.0, 0.0, -1.0 / 30.0, 0.0, 1.0 / 42.0, 0.0, -1.0 / 30.0,
+		0.0, 5.0 / 66.0, 0.0, -691.0 / 2730.0, 0.0, 7.0 / 6.0, 0.0, -3617.0 / 510.0
+	};
+
+	const auto L = std::log1p(t);
+
+	// L^(n + 1) / (n + 1)!
+	auto power = L;
+	auto series = 0.0;
+
+	for (int n = 0; n < static_cast<int>(std::size(bernoulli)); n++)
+	{
+		series += bernoulli[n] * power;
+		power *= L / static_cast<double>(n + 2);
+	}
+
+	return -L * L * 0.5 - series;
+}
+
+template class AntiderivativeWaveshaper<float>;
+template class AntiderivativeWaveshaper<double>;
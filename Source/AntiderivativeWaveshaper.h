@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    AntiderivativeWaveshaper.h
+    Created: 18 Oct 2026 3:41:18am
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+//
+// Sigmoid waveshaper with antiderivative anti-aliasing (ADAA), first or second order.
+// Instead of the curve at each sample, it outputs the curve averaged over the line between the samples,
+// from the closed form antiderivatives. Most of the aliasing goes without oversampling or added latency.
+//
+// The dry part of the mix is lined up with the shaped one, so they don't comb filter at the mixes in between:
+// (x[n] + x[n - 1]) / 2 at the first order, which is as far as its half sample of delay goes,
+// & x[n - 1] at the second. At no mix nothing is shaped & the dry samples are left as they are.
+//
+// The math is done in double precision, the difference quotients lose too much in float.
+//
+template<typename SampleType>
+class AntiderivativeWaveshaper
+{
+public:
+	// The sigmoids of CossackAudioProcessor::testHarmonics(), each normalised to 1 at the input of 1
+	enum class Curve
+	{
+		logistic,
+		atan,
+		tanh
+	};
+
+	AntiderivativeWaveshaper();
+
+	void prepare(const juce::dsp::ProcessSpec& spec);
+
+	void reset();
+
+	// 1 or 2. Delays by half a sample at the first order, with the treble of the averaging,
+	// & by a whole one at the second.
+	// At no mix, the first order passes the samples as they are & the second only delays them.
+	void setOrder(int order);
+	int getOrder() const;
+
+	// Saturation is 0..1, same as in testHarmonics()
+	void setCurve(Curve curve, float saturation);
+
+	// Mix between the dry & the shaped samples, 0..1
+	void process(const juce::dsp::AudioBlock<SampleType>& block, SampleType mix);
+
+private:
+	// Differences smaller than this fall back to the curve itself
+	static constexpr double tolerance = 1.0e-5;
+
+	static constexpr double ln2 = 0.69314718055994530942;
+
+	// The curve, its first & second antiderivatives
+	double shape(double x) const;
+	double getAntiderivative1(double x) const;
+	double getAntiderivative2(double x) const;
+
+	// ln(cosh(u)) & its antiderivative, for the tanh shaped curves
+	static double getLogCosh(double u);
+	static double getLogCoshIntegral(double u);
+
+	// Dilogarithm Li2(-t) for t in [0, 1]
+	static double getDilogarithm(double t);
+
+	template<int Order>
+	void processOrder(const juce::dsp::AudioBlock<SampleType>& block, double mix);
+
+	Curve curve_;
+
+	// Input scale & the normalising gain of the curve
+	double scale_;
+	double gain_;
+
+	int order_;
+
+	// Last two input samples per channel
+	struct State
+	{
+		double x1;
+		double x2;
+	};
+
+	std::vector<State> states_;
+};
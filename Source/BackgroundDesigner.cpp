@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+    BackgroundDesigner.cpp
+    Created: 17 Oct 2026 7:41:26pm
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#include "BackgroundDesigner.h"
+
+BackgroundDesigner::BackgroundDesigner() :
+	juce::Thread("Cossack filter design")
+{
+	startThread();
+}
+
+BackgroundDesigner::~BackgroundDesigner()
+{
+	stopThread(1000);
+}
+
+void BackgroundDesigner::addClient(Client* client)
+{
+	const juce::ScopedLock lock(clientLock_);
+	clients_.push_back(client);
+}
+
+void BackgroundDesigner::removeClient(Client* client)
+{
+	const juce::ScopedLock lock(clientLock_);
+	clients_.erase(std::remove(clients_.begin(), clients_.end(), client), clients_.end());
+}
+
+void BackgroundDesigner::run()
+{
+	while (!threadShouldExit())
+	{
+		{
+			const juce::ScopedLock lock(clientLock_);
+
+			for (auto* client : clients_)
+				client->designInBackground();
+		}
+
+		wait(pollInterval);
+	}
+}
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    BackgroundDesigner.h
+    Created: 17 Oct 2026 7:41:26pm
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+//
+// Worker thread for the filter designs too heavy for the audio thread.
+//
+// Every client is polled periodically. A client compares the requested settings with the ones
+// it was last designed for, designs into its inactive buffer & flags it ready.
+// The audio thread then swaps the buffers at the start of a block.
+//
+class BackgroundDesigner : private juce::Thread
+{
+public:
+	class Client
+	{
+	public:
+		virtual ~Client() = default;
+
+		// Called from the worker thread, never concurrently with itself
+		virtual void designInBackground() = 0;
+	};
+
+	BackgroundDesigner();
+	~BackgroundDesigner() override;
+
+	void addClient(Client* client);
+	void removeClient(Client* client);
+
+private:
+	static constexpr int pollInterval = 20;
+
+	void run() override;
+
+	juce::CriticalSection clientLock_;
+	std::vector<Client*> clients_;
+};
@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    BandGainProcessor.cpp
+    Created: 17 Oct 2026 11:34:52pm
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#include "BandGainProcessor.h"
+
+template<typename SampleType>
+BandGainProcessor<SampleType>::BandGainProcessor() :
+	channelCount_(0)
+{
+	for (int band = 0; band < maximumBandCount; band++)
+	{
+		std::fill(std::begin(gains_[band]), std::end(gains_[band]), static_cast<SampleType>(1));
+		std::fill(std::begin(targets_[band]), std::end(targets_[band]), static_cast<SampleType>(1));
+	}
+}
+
+template<typename SampleType>
+void BandGainProcessor<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+{
+	jassert(spec.numChannels <= maximumChannelCount);
+
+	channelCount_ = juce::jmin(static_cast<size_t>(spec.numChannels), maximumChannelCount);
+
+	for (int band = 0; band < maximumBandCount; band++)
+	{
+		std::fill(std::begin(gains_[band]), std::end(gains_[band]), static_cast<SampleType>(1));
+		std::fill(std::begin(targets_[band]), std::end(targets_[band]), static_cast<SampleType>(1));
+	}
+}
+
+template<typename SampleType>
+void BandGainProcessor<SampleType>::setGainDecibels(int band, size_t channel, SampleType gainDecibels)
+{
+	jassert(band >= 0 && band < maximumBandCount && channel < channelCount_);
+
+	targets_[band][channel] = juce::Decibels::decibelsToGain(gainDecibels);
+}
+
+template<typename SampleType>
+bool BandGainProcessor<SampleType>::isNeutral(int band) const
+{
+	for (size_t ch = 0; ch < channelCount_; ch++)
+	{
+		if (gains_[band][ch] != static_cast<SampleType>(1) || targets_[band][ch] != static_cast<SampleType>(1))
+			return false;
+	}
+
+	return true;
+}
+
+template<typename SampleType>
+void BandGainProcessor<SampleType>::process(int band, const juce::dsp::AudioBlock<SampleType>& block)
+{
+	jassert(block.getNumChannels() == channelCount_);
+
+	const auto numSamples = block.getNumSamples();
+
+	if (numSamples == 0)
+		return;
+
+	for (size_t ch = 0; ch < channelCount_; ch++)
+	{
+		auto* samples = block.getChannelPointer(ch);
+		const auto gain = gains_[band][ch];
+		const auto target = targets_[band][ch];
+
+		if (gain == target)
+		{
+			juce::FloatVectorOperations::multiply(samples, gain, static_cast<int>(numSamples));
+			continue;
+		}
+
+		// Linear ramp, reaching the target on the last sample
+		const auto step = (target - gain) / static_cast<SampleType>(numSamples);
+
+		for (size_t j = 0; j < numSamples; j++)
+			samples[j] *= gain + step * static_cast<SampleType>(j + 1);
+
+		gains_[band][ch] = target;
+	}
+}
+
+template class BandGainProcessor<float>;
+template class BandGainProcessor<double>;
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    BandGainProcessor.h
+    Created: 17 Oct 2026 11:34:52pm
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Common.h"
+
+//
+// Gains of the split bands, one per band & channel.
+//
+// A new gain is ramped to over the next block of the band, whatever its length or sample rate,
+// and the block is then scaled with the vectorised juce::FloatVectorOperations.
+//
+template<typename SampleType>
+class BandGainProcessor
+{
+public:
+	static constexpr int maximumBandCount = CossackConstants::bandCount;
+
+	BandGainProcessor();
+
+	// Jumps all the gains back to unity
+	void prepare(const juce::dsp::ProcessSpec& spec);
+
+	void setGainDecibels(int band, size_t channel, SampleType gainDecibels);
+
+	// At unity on all the channels, with nothing left to ramp.
+	// The band can be left as it is.
+	bool isNeutral(int band) const;
+
+	// Scale the band's block, all the channels of it
+	void process(int band, const juce::dsp::AudioBlock<SampleType>& block);
+
+private:
+	static constexpr size_t maximumChannelCount = 2;
+
+	// Gain at the end of the last block & the one to ramp to, maximumBandCount * maximumChannelCount
+	SampleType gains_[maximumBandCount][maximumChannelCount];
+	SampleType targets_[maximumBandCount][maximumChannelCount];
+
+	size_t channelCount_;
+};
@@ -0,0 +1,411 @@
+/*
+  ==============================================================================
+
+    BiquadCascade.cpp
+    Created: 17 Oct 2026 9:47:20pm
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#include "BiquadCascade.h"
+
+template<typename SampleType, int MaximumSectionCount>
+BiquadCascade<SampleType, MaximumSectionCount>::BiquadCascade() :
+	sampleRate_(44100.0),
+	smoothingTime_(0.0),
+	smoothingLength_(0),
+	sectionCount_(MaximumSectionCount),
+	channelCount_(0)
+{
+	std::fill(std::begin(glideRemaining_), std::end(glideRemaining_), 0);
+	std::fill(std::begin(hasCoefficients_), std::end(hasCoefficients_), false);
+}
+
+template<typename SampleType, int MaximumSectionCount>
+void BiquadCascade<SampleType, MaximumSectionCount>::prepare(const juce::dsp::ProcessSpec& spec)
+{
+	sampleRate_ = spec.sampleRate;
+	channelCount_ = spec.numChannels;
+
+	setSmoothingTime(smoothingTime_);
+
+	// Coefficients of the old sample rate are no good to glide from
+	std::fill(std::begin(hasCoefficients_), std::end(hasCoefficients_), false);
+
+	states_.resize(maximumSectionCount * channelCount_);
+
+	reset();
+}
+
+template<typename SampleType, int MaximumSectionCount>
+void BiquadCascade<SampleType, MaximumSectionCount>::process(const juce::dsp::ProcessContextReplacing<SampleType>& context)
+{
+	const auto& block = context.getOutputBlock();
+
+	jassert(block.getNumChannels() == channelCount_);
+
+	if (context.isBypassed || sectionCount_ == 0)
+		return;
+
+	// Gliding part first, the rest of the block with the coefficients held
+	const auto numSamples = block.getNumSamples();
+	const auto glideLength = juce::jmin(getGlideLength(), numSamples);
+
+	if (glideLength > 0)
+		processScalar<true>(block.getSubBlock(0, glideLength));
+
+	if (glideLength < numSamples)
+		processScalar<false>(block.getSubBlock(glideLength));
+}
+
+template<typename SampleType, int MaximumSectionCount>
+template<int... NextSectionCounts>
+void BiquadCascade<SampleType, MaximumSectionCount>::processChain(const juce::dsp::AudioBlock<SampleType>& block, BiquadCascade<SampleType, NextSectionCounts>&... next)
+{
+	jassert(block.getNumChannels() == channelCount_);
+	jassert(((next.channelCount_ == channelCount_) && ...));
+
+	// Gliding until the last of them is done
+	const auto numSamples = block.getNumSamples();
+	const auto glideLength = juce::jmin(std::max({ getGlideLength(), next.getGlideLength()... }), numSamples);
+
+	if (glideLength > 0)
+		processChainScalar<true>(block.getSubBlock(0, glideLength), next...);
+
+	if (glideLength < numSamples)
+		processChainScalar<false>(block.getSubBlock(glideLength), next...);
+}
+
+#if JUCE_USE_SIMD
+template<typename SampleType, int MaximumSectionCount>
+template<int... NextSectionCounts>
+void BiquadCascade<SampleType, MaximumSectionCount>::processChainPair(const juce::dsp::AudioBlock<SampleType>& first, const juce::dsp::AudioBlock<SampleType>& second,
+	BiquadCascade* const (&cascades)[2], BiquadCascade<SampleType, NextSectionCounts>* const (&... next)[2])
+{
+	jassert(first.getNumChannels() == 1 && second.getNumChannels() == 1);
+	jassert(first.getNumSamples() == second.getNumSamples());
+	jassert(cascades[0]->channelCount_ == 1 && cascades[1]->channelCount_ == 1);
+
+	std::tuple<Lanes, typename BiquadCascade<SampleType, NextSectionCounts>::Lanes...> stages(cascades, next...);
+
+	std::apply([&](auto&... stage) { processLanes(first, second, stage...); }, stages);
+}
+
+template<typename SampleType, int MaximumSectionCount>
+template<typename... Stages>
+void BiquadCascade<SampleType, MaximumSectionCount>::processLanes(const juce::dsp::AudioBlock<SampleType>& first, const juce::dsp::AudioBlock<SampleType>& second, Stages&... stages)
+{
+	const auto numSamples = first.getNumSamples();
+	const auto glideLength = juce::jmin(std::max({ stages.getGlideLength()... }), numSamples);
+
+	auto* firstSamples = first.getChannelPointer(0);
+	auto* secondSamples = second.getChannelPointer(0);
+
+	// Unused lanes stay at zero
+	alignas(SIMDType::SIMDRegisterSize) SampleType lanes[SIMDType::SIMDNumElements]{};
+
+	(stages.loadCoefficients(), ...);
+
+	for (size_t j = 0; j < numSamples; j++)
+	{
+		if (j < glideLength)
+		{
+			(stages.advanceGlides(), ...);
+			(stages.loadCoefficients(), ...);
+		}
+
+		lanes[0] = firstSamples[j];
+		lanes[1] = secondSamples[j];
+
+		auto x = SIMDType::fromRawArray(lanes);
+		((x = stages.process(x)), ...);
+		x.copyToRawArray(lanes);
+
+		firstSamples[j] = lanes[0];
+		secondSamples[j] = lanes[1];
+	}
+
+	(stages.storeStates(), ...);
+}
+
+template<typename SampleType, int MaximumSectionCount>
+BiquadCascade<SampleType, MaximumSectionCount>::Lanes::Lanes(BiquadCascade* const (&pair)[2]) :
+	cascades{ pair[0], pair[1] },
+	sectionCount(juce::jmax(pair[0]->sectionCount_, pair[1]->sectionCount_))
+{
+	// Past a cascade's section count its lane starts from silence, nothing is handed back from there
+	const auto getState = [&](int i, int n)
+	{
+		return n < cascades[i]->sectionCount_ ? cascades[i]->states_[n] : State();
+	};
+
+	for (int n = 0; n < sectionCount; n++)
+	{
+		const auto firstState = getState(0, n);
+		const auto secondState = getState(1, n);
+
+		states[n].s1 = pack(firstState.s1, secondState.s1);
+		states[n].s2 = pack(firstState.s2, secondState.s2);
+	}
+}
+
+template<typename SampleType, int MaximumSectionCount>
+size_t BiquadCascade<SampleType, MaximumSectionCount>::Lanes::getGlideLength() const
+{
+	return juce::jmax(cascades[0]->getGlideLength(), cascades[1]->getGlideLength());
+}
+
+template<typename SampleType, int MaximumSectionCount>
+void BiquadCascade<SampleType, MaximumSectionCount>::Lanes::advanceGlides()
+{
+	cascades[0]->advanceGlides();
+	cascades[1]->advanceGlides();
+}
+
+template<typename SampleType, int MaximumSectionCount>
+void BiquadCascade<SampleType, MaximumSectionCount>::Lanes::loadCoefficients()
+{
+	const auto getCoefficients = [&](int i, int n)
+	{
+		return n < cascades[i]->sectionCount_ ? cascades[i]->coefficients_[n] : Coefficients();
+	};
+
+	for (int n = 0; n < sectionCount; n++)
+	{
+		const auto first = getCoefficients(0, n);
+		const auto second = getCoefficients(1, n);
+		auto& c = coefficients[n];
+
+		c.a1 = pack(first.a1, second.a1);
+		c.a2 = pack(first.a2, second.a2);
+		c.a3 = pack(first.a3, second.a3);
+		c.m0 = pack(first.m0, second.m0);
+		c.m1 = pack(first.m1, second.m1);
+		c.m2 = pack(first.m2, second.m2);
+	}
+}
+
+template<typename SampleType, int MaximumSectionCount>
+void BiquadCascade<SampleType, MaximumSectionCount>::Lanes::storeStates()
+{
+	alignas(SIMDType::SIMDRegisterSize) SampleType s1[SIMDType::SIMDNumElements];
+	alignas(SIMDType::SIMDRegisterSize) SampleType s2[SIMDType::SIMDNumElements];
+
+	for (int n = 0; n < sectionCount; n++)
+	{
+		states[n].s1.copyToRawArray(s1);
+		states[n].s2.copyToRawArray(s2);
+
+		for (int i = 0; i < 2; i++)
+		{
+			if (n < cascades[i]->sectionCount_)
+			{
+				cascades[i]->states_[n].s1 = s1[i];
+				cascades[i]->states_[n].s2 = s2[i];
+			}
+		}
+	}
+}
+
+template<typename SampleType, int MaximumSectionCount>
+typename BiquadCascade<SampleType, MaximumSectionCount>::SIMDType BiquadCascade<SampleType, MaximumSectionCount>::Lanes::process(SIMDType x) noexcept
+{
+	for (int n = 0; n < sectionCount; n++)
+		x = states[n].process(coefficients[n], x);
+
+	return x;
+}
+
+template<typename SampleType, int MaximumSectionCount>
+typename BiquadCascade<SampleType, MaximumSectionCount>::SIMDType BiquadCascade<SampleType, MaximumSectionCount>::pack(SampleType first, SampleType second)
+{
+	alignas(SIMDType::SIMDRegisterSize) SampleType lanes[SIMDType::SIMDNumElements]{};
+	lanes[0] = first;
+	lanes[1] = second;
+
+	return SIMDType::fromRawArray(lanes);
+}
+#endif
+
+template<typename SampleType, int MaximumSectionCount>
+size_t BiquadCascade<SampleType, MaximumSectionCount>::getGlideLength() const
+{
+	int length = 0;
+
+	for (int n = 0; n < sectionCount_; n++)
+		length = juce::jmax(length, glideRemaining_[n]);
+
+	return static_cast<size_t>(length);
+}
+
+template<typename SampleType, int MaximumSectionCount>
+void BiquadCascade<SampleType, MaximumSectionCount>::advanceGlides()
+{
+	for (int n = 0; n < sectionCount_; n++)
+	{
+		if (glideRemaining_[n] == 0)
+			continue;
+
+		// Land exactly on the target
+		if (--glideRemaining_[n] == 0)
+			coefficients_[n] = targets_[n];
+		else
+			coefficients_[n].advance(steps_[n]);
+	}
+}
+
+template<typename SampleType, int MaximumSectionCount>
+SampleType BiquadCascade<SampleType, MaximumSectionCount>::processSample(size_t channel, SampleType sample) noexcept
+{
+	auto* states = states_.data() + channel * maximumSectionCount;
+
+	for (int n = 0; n < sectionCount_; n++)
+		sample = states[n].process(coefficients_[n], sample);
+
+	return sample;
+}
+
+template<typename SampleType, int MaximumSectionCount>
+template<bool IsGliding>
+void BiquadCascade<SampleType, MaximumSectionCount>::processScalar(const juce::dsp::AudioBlock<SampleType>& block)
+{
+	const auto numSamples = block.getNumSamples();
+
+	for (size_t j = 0; j < numSamples; j++)
+	{
+		if constexpr (IsGliding)
+			advanceGlides();
+
+		for (size_t ch = 0; ch < channelCount_; ch++)
+		{
+			auto* samples = block.getChannelPointer(ch);
+			samples[j] = processSample(ch, samples[j]);
+		}
+	}
+}
+
+template<typename SampleType, int MaximumSectionCount>
+template<bool IsGliding, int... NextSectionCounts>
+void BiquadCascade<SampleType, MaximumSectionCount>::processChainScalar(const juce::dsp::AudioBlock<SampleType>& block, BiquadCascade<SampleType, NextSectionCounts>&... next)
+{
+	const auto numSamples = block.getNumSamples();
+
+	for (size_t j = 0; j < numSamples; j++)
+	{
+		if constexpr (IsGliding)
+		{
+			advanceGlides();
+			(next.advanceGlides(), ...);
+		}
+
+		for (size_t ch = 0; ch < channelCount_; ch++)
+		{
+			auto* samples = block.getChannelPointer(ch);
+			auto sample = processSample(ch, samples[j]);
+
+			((sample = next.processSample(ch, sample)), ...);
+
+			samples[j] = sample;
+		}
+	}
+}
+
+template<typename SampleType, int MaximumSectionCount>
+void BiquadCascade<SampleType, MaximumSectionCount>::reset()
+{
+	for (int n = 0; n < maximumSectionCount; n++)
+	{
+		if (glideRemaining_[n] > 0)
+			coefficients_[n] = targets_[n];
+
+		glideRemaining_[n] = 0;
+	}
+
+	for (auto& state : states_)
+		state.reset();
+}
+
+template<typename SampleType, int MaximumSectionCount>
+void BiquadCascade<SampleType, MaximumSectionCount>::setCoefficients(int n, const BiquadCoefficients<SampleType>& coefficients)
+{
+	jassert(n >= 0 && n < maximumSectionCount);
+
+	targets_[n] = coefficients;
+
+	if (smoothingLength_ == 0 || !hasCoefficients_[n])
+	{
+		coefficients_[n] = coefficients;
+		glideRemaining_[n] = 0;
+	}
+	else
+	{
+		// From wherever the last glide got to
+		steps_[n] = Coefficients::getStep(coefficients_[n], coefficients, smoothingLength_);
+		glideRemaining_[n] = smoothingLength_;
+	}
+
+	hasCoefficients_[n] = true;
+}
+
+template<typename SampleType, int MaximumSectionCount>
+void BiquadCascade<SampleType, MaximumSectionCount>::setSmoothingTime(double seconds)
+{
+	jassert(seconds >= 0.0);
+
+	smoothingTime_ = seconds;
+	smoothingLength_ = juce::roundToInt(smoothingTime_ * sampleRate_);
+}
+
+template<typename SampleType, int MaximumSectionCount>
+void BiquadCascade<SampleType, MaximumSectionCount>::setSectionCount(int count)
+{
+	jassert(count >= 0 && count <= maximumSectionCount);
+
+	// Whatever was left in the states of the sections brought back is stale
+	for (int n = sectionCount_; n < count; n++)
+	{
+		if (glideRemaining_[n] > 0)
+			coefficients_[n] = targets_[n];
+
+		glideRemaining_[n] = 0;
+
+		for (size_t ch = 0; ch < channelCount_; ch++)
+			states_[ch * maximumSectionCount + n].reset();
+	}
+
+	sectionCount_ = count;
+}
+
+template<typename SampleType, int MaximumSectionCount>
+int BiquadCascade<SampleType, MaximumSectionCount>::getSectionCount() const
+{
+	return sectionCount_;
+}
+
+// Equalizer bands
+template class BiquadCascade<float, 10>;
+template class BiquadCascade<double, 10>;
+// Low/high cuts
+template class BiquadCascade<float, 8>;
+template class BiquadCascade<double, 8>;
+
+// Chains of the mid/side paths: low cut, equalizer & high cut
+template void BiquadCascade<float, 8>::processChain<10, 8>(const juce::dsp::AudioBlock<float>&, BiquadCascade<float, 10>&, BiquadCascade<float, 8>&);
+template void BiquadCascade<float, 8>::processChain<10>(const juce::dsp::AudioBlock<float>&, BiquadCascade<float, 10>&);
+template void BiquadCascade<float, 10>::processChain<8>(const juce::dsp::AudioBlock<float>&, BiquadCascade<float, 8>&);
+template void BiquadCascade<double, 8>::processChain<10, 8>(const juce::dsp::AudioBlock<double>&, BiquadCascade<double, 10>&, BiquadCascade<double, 8>&);
+template void BiquadCascade<double, 8>::processChain<10>(const juce::dsp::AudioBlock<double>&, BiquadCascade<double, 10>&);
+template void BiquadCascade<double, 10>::processChain<8>(const juce::dsp::AudioBlock<double>&, BiquadCascade<double, 8>&);
+
+#if JUCE_USE_SIMD
+// Same, the mid & the side path as the two lanes
+template void BiquadCascade<float, 8>::processChainPair<10, 8>(const juce::dsp::AudioBlock<float>&, const juce::dsp::AudioBlock<float>&, BiquadCascade<float, 8>* const (&)[2], BiquadCascade<float, 10>* const (&)[2], BiquadCascade<float, 8>* const (&)[2]);
+template void BiquadCascade<float, 8>::processChainPair<10>(const juce::dsp::AudioBlock<float>&, const juce::dsp::AudioBlock<float>&, BiquadCascade<float, 8>* const (&)[2], BiquadCascade<float, 10>* const (&)[2]);
+template void BiquadCascade<float, 10>::processChainPair<8>(const juce::dsp::AudioBlock<float>&, const juce::dsp::AudioBlock<float>&, BiquadCascade<float, 10>* const (&)[2], BiquadCascade<float, 8>* const (&)[2]);
+template void BiquadCascade<float, 10>::processChainPair<>(const juce::dsp::AudioBlock<float>&, const juce::dsp::AudioBlock<float>&, BiquadCascade<float, 10>* const (&)[2]);
+template void BiquadCascade<double, 8>::processChainPair<10, 8>(const juce::dsp::AudioBlock<double>&, const juce::dsp::AudioBlock<double>&, BiquadCascade<double, 8>* const (&)[2], BiquadCascade<double, 10>* const (&)[2], BiquadCascade<double, 8>* const (&)[2]);
+template void BiquadCascade<double, 8>::processChainPair<10>(const juce::dsp::AudioBlock<double>&, const juce::dsp::AudioBlock<double>&, BiquadCascade<double, 8>* const (&)[2], BiquadCascade<double, 10>* const (&)[2]);
+template void BiquadCascade<double, 10>::processChainPair<8>(const juce::dsp::AudioBlock<double>&, const juce::dsp::AudioBlock<double>&, BiquadCascade<double, 10>* const (&)[2], BiquadCascade<double, 8>* const (&)[2]);
+template void BiquadCascade<double, 10>::processChainPair<>(const juce::dsp::AudioBlock<double>&, const juce::dsp::AudioBlock<double>&, BiquadCascade<double, 10>* const (&)[2]);
+#endif
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    BiquadCascade.h
+    Created: 17 Oct 2026 9:47:20pm
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <tuple>
+#include <vector>
+#include "BiquadKernel.h"
+
+//
+// Cascade of up to MaximumSectionCount biquads, all run in a single pass over the block.
+// Each sample is read & written once, going through all the sections in between.
+// The sections are stored contiguously, retuning or changing their number allocates nothing.
+//
+// New coefficients glide in sample by sample over the smoothing time,
+// so that automation doesn't zipper however large the blocks are.
+//
+// Two mono cascades, like those of the mid & the side path, can run as lanes of one SIMD register,
+// each lane with its own coefficients. See processChainPair().
+//
+template<typename SampleType, int MaximumSectionCount>
+class BiquadCascade
+{
+public:
+	static constexpr int maximumSectionCount = MaximumSectionCount;
+
+	BiquadCascade();
+
+	void prepare(const juce::dsp::ProcessSpec& spec);
+
+	void process(const juce::dsp::ProcessContextReplacing<SampleType>& context);
+
+	// Same as processing this cascade & then the next ones, but in a single pass over the block,
+	// each sample going through all of their sections at once. They all need the same channel count.
+	template<int... NextSectionCounts>
+	void processChain(const juce::dsp::AudioBlock<SampleType>& block, BiquadCascade<SampleType, NextSectionCounts>&... next);
+
+#if JUCE_USE_SIMD
+	// Same as processChain() on two mono blocks at once, the first in lane 0 & the second in lane 1.
+	// cascades & each of next hold a stage's cascade of the first & of the second block, all prepared mono.
+	template<int... NextSectionCounts>
+	static void processChainPair(const juce::dsp::AudioBlock<SampleType>& first, const juce::dsp::AudioBlock<SampleType>& second,
+		BiquadCascade* const (&cascades)[2], BiquadCascade<SampleType, NextSectionCounts>* const (&... next)[2]);
+#endif
+
+	// Also finishes the glides
+	void reset();
+
+	// Sections past the count are left out. The ones brought back start from silence.
+	void setSectionCount(int count);
+	int getSectionCount() const;
+
+	// Glides there from the next process() on, allocates nothing.
+	// The first coefficients after prepare() are used right away.
+	void setCoefficients(int n, const BiquadCoefficients<SampleType>& coefficients);
+
+	// Length of the glide to new coefficients, 0 switches at the next block
+	void setSmoothingTime(double seconds);
+
+private:
+	// The chains reach into each other's sections
+	template<typename, int>
+	friend class BiquadCascade;
+
+	using Coefficients = BiquadCoefficients<SampleType>;
+	using State = BiquadState<SampleType>;
+
+	// Samples left until the last section is done gliding
+	size_t getGlideLength() const;
+
+	// One sample further along the glides
+	void advanceGlides();
+
+	// One sample of a channel through the sections
+	SampleType processSample(size_t channel, SampleType sample) noexcept;
+
+	// Sample by sample, all the channels at each
+	template<bool IsGliding>
+	void processScalar(const juce::dsp::AudioBlock<SampleType>& block);
+
+	// Same, on through the next cascades
+	template<bool IsGliding, int... NextSectionCounts>
+	void processChainScalar(const juce::dsp::AudioBlock<SampleType>& block, BiquadCascade<SampleType, NextSectionCounts>&... next);
+
+#if JUCE_USE_SIMD
+	using SIMDType = juce::dsp::SIMDRegister<SampleType>;
+	using SIMDCoefficients = BiquadCoefficients<SIMDType>;
+	using SIMDState = BiquadState<SIMDType>;
+
+	// A stage of processChainPair(), the sections of its two cascades side by side.
+	// The states are taken from the cascades & handed back, so the pairing can start & stop at any block.
+	struct Lanes
+	{
+		explicit Lanes(BiquadCascade* const (&pair)[2]);
+
+		size_t getGlideLength() const;
+		void advanceGlides();
+
+		// Current coefficients of both cascades, identity past the section count of the shorter one
+		void loadCoefficients();
+		void storeStates();
+
+		SIMDType process(SIMDType x) noexcept;
+
+		BiquadCascade* cascades[2];
+		int sectionCount;
+		SIMDCoefficients coefficients[maximumSectionCount];
+		SIMDState states[maximumSectionCount];
+	};
+
+	// The first two lanes of a register
+	static SIMDType pack(SampleType first, SampleType second);
+
+	// Sample by sample through all the stages, repacking the coefficients while any of them glides
+	template<typename... Stages>
+	static void processLanes(const juce::dsp::AudioBlock<SampleType>& first, const juce::dsp::AudioBlock<SampleType>& second, Stages&... stages);
+#endif
+
+	double sampleRate_;
+	double smoothingTime_;
+	int smoothingLength_;
+
+	int sectionCount_;
+
+	// Current coefficients, where they glide to, the step per sample & the samples left
+	Coefficients coefficients_[maximumSectionCount];
+	Coefficients targets_[maximumSectionCount];
+	Coefficients steps_[maximumSectionCount];
+	int glideRemaining_[maximumSectionCount];
+	bool hasCoefficients_[maximumSectionCount];
+
+	// maximumSectionCount per channel
+	std::vector<State> states_;
+
+	size_t channelCount_;
+};
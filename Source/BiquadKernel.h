@@ -0,0 +1,177 @@
+/*
+  ==============================================================================
+
+    BiquadKernel.h
+    Created: 17 Oct 2026 9:12:45pm
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//
+// Equalizer & cut biquad math, the same RBJ responses as juce::dsp::IIR::Coefficients,
+// but written into existing storage instead of a new heap allocated object.
+//
+// The sections are trapezoidal state variable filters (Andrew Simper's SVF),
+// which stay stable & quiet while the coefficients move from sample to sample.
+// The design parameters g, k & the output mix interpolate linearly, the rest follows with update().
+//
+// The state's VectorType is either a plain sample type (one state per channel)
+// or a juce::dsp::SIMDRegister (one channel per register lane).
+// The coefficients can be either as well, a register of them gives each lane its own.
+// Only the members are used then, the designs are done per lane on the plain type.
+//
+
+template<typename NumericType>
+struct BiquadCoefficients
+{
+	void setLowShelf(double sampleRate, double frequency, double Q, double gain)
+	{
+		const auto A = std::sqrt(juce::jmax(gain, 0.000001));
+
+		set(getPrewarped(sampleRate, frequency) / std::sqrt(A), 1.0 / Q,
+			1.0, (A - 1.0) / Q, A * A - 1.0);
+	}
+
+	void setPeak(double sampleRate, double frequency, double Q, double gain)
+	{
+		const auto A = std::sqrt(juce::jmax(gain, 0.000001));
+		const auto k = 1.0 / (Q * A);
+
+		set(getPrewarped(sampleRate, frequency), k,
+			1.0, k * (A * A - 1.0), 0.0);
+	}
+
+	void setHighShelf(double sampleRate, double frequency, double Q, double gain)
+	{
+		const auto A = std::sqrt(juce::jmax(gain, 0.000001));
+
+		set(getPrewarped(sampleRate, frequency) * std::sqrt(A), 1.0 / Q,
+			A * A, (1.0 - A) * A / Q, 1.0 - A * A);
+	}
+
+	void setLowPass(double sampleRate, double frequency, double Q)
+	{
+		set(getPrewarped(sampleRate, frequency), 1.0 / Q,
+			0.0, 0.0, 1.0);
+	}
+
+	void setHighPass(double sampleRate, double frequency, double Q)
+	{
+		set(getPrewarped(sampleRate, frequency), 1.0 / Q,
+			1.0, -1.0 / Q, -1.0);
+	}
+
+	// First order responses, the critically damped section with one of its poles cancelled
+	void setFirstOrderLowPass(double sampleRate, double frequency)
+	{
+		set(getPrewarped(sampleRate, frequency), 2.0,
+			0.0, 1.0, 1.0);
+	}
+
+	void setFirstOrderHighPass(double sampleRate, double frequency)
+	{
+		set(getPrewarped(sampleRate, frequency), 2.0,
+			1.0, -1.0, -1.0);
+	}
+
+	// Move by the difference of the design parameters, see getStep()
+	void advance(const BiquadCoefficients& step) noexcept
+	{
+		g += step.g;
+		k += step.k;
+		m0 += step.m0;
+		m1 += step.m1;
+		m2 += step.m2;
+
+		update();
+	}
+
+	// Difference of the design parameters, spread over the given number of steps
+	static BiquadCoefficients getStep(const BiquadCoefficients& from, const BiquadCoefficients& to, int stepCount) noexcept
+	{
+		const auto scale = static_cast<NumericType>(1) / static_cast<NumericType>(stepCount);
+
+		BiquadCoefficients step;
+		step.g = (to.g - from.g) * scale;
+		step.k = (to.k - from.k) * scale;
+		step.m0 = (to.m0 - from.m0) * scale;
+		step.m1 = (to.m1 - from.m1) * scale;
+		step.m2 = (to.m2 - from.m2) * scale;
+
+		return step;
+	}
+
+	// Recalculate the filter coefficients from the design parameters
+	void update() noexcept
+	{
+		a1 = static_cast<NumericType>(1) / (static_cast<NumericType>(1) + g * (g + k));
+		a2 = g * a1;
+		a3 = g * a2;
+	}
+
+	// Design parameters: prewarped frequency, damping & the mix of the input, band & low outputs.
+	// Identity by default.
+	NumericType g = 0;
+	NumericType k = 2;
+	NumericType m0 = 1;
+	NumericType m1 = 0;
+	NumericType m2 = 0;
+
+	// Filter coefficients
+	NumericType a1 = 1;
+	NumericType a2 = 0;
+	NumericType a3 = 0;
+
+private:
+	static double getPrewarped(double sampleRate, double frequency)
+	{
+		// Keep away from Nyquist, where tan() blows up
+		frequency = juce::jlimit(2.0, 0.49 * sampleRate, frequency);
+
+		return std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+	}
+
+	void set(double ng, double nk, double nm0, double nm1, double nm2)
+	{
+		g = static_cast<NumericType>(ng);
+		k = static_cast<NumericType>(nk);
+		m0 = static_cast<NumericType>(nm0);
+		m1 = static_cast<NumericType>(nm1);
+		m2 = static_cast<NumericType>(nm2);
+
+		update();
+	}
+};
+
+template<typename VectorType>
+struct BiquadState
+{
+	using NumericType = typename juce::dsp::SampleTypeHelpers::ElementType<VectorType>::Type;
+
+	void reset()
+	{
+		s1 = s2 = VectorType(static_cast<NumericType>(0));
+	}
+
+	// NOTE: Scalars always go on the right side of the operators, SIMDRegister only has those overloads.
+	template<typename CoefficientType>
+	inline VectorType process(const BiquadCoefficients<CoefficientType>& c, VectorType x) noexcept
+	{
+		const VectorType v3 = x - s2;
+		const VectorType v1 = s1 * c.a1 + v3 * c.a2;
+		const VectorType v2 = s2 + s1 * c.a2 + v3 * c.a3;
+
+		s1 = v1 * static_cast<NumericType>(2) - s1;
+		s2 = v2 * static_cast<NumericType>(2) - s2;
+
+		return x * c.m0 + v1 * c.m1 + v2 * c.m2;
+	}
+
+	// Integrator states
+	VectorType s1, s2;
+};
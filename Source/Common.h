@@ -20,8 +20,45 @@ public:
 	static constexpr int bandCount = std::size(bandFrequencies);
 	static_assert(bandCount >= 1);
 
-	// Crossover frequencies, always one less than the number of bands
+	// Default crossover frequencies, always one less than the number of bands.
+	// Each one is adjustable between the central frequencies of its bands.
 	static constexpr float crossoverFrequencies[]{ 46.875f, 93.75f, 187.5f, 375.f, 750.f, 1500.f, 3000.f, 6000.f, 12000.f };
 	static constexpr int crossoverCount = std::size(crossoverFrequencies);
 	static_assert(crossoverCount == (bandCount - 1));
+
+	// Equalizer gain range in dB, the parameters snap to the steps
+	static constexpr float equalizerGainMinimum = -12.f;
+	static constexpr float equalizerGainMaximum = 12.f;
+	static constexpr float equalizerGainStep = 0.1f;
+
+	// Layouts of the multi-band split, from the full one down to the cheapest.
+	// Each layout uses a subset of the crossovers above, so its bands span several full layout bands.
+	struct BandLayout
+	{
+		int bandCount;
+		int crossovers[crossoverCount];
+
+		// First & last full layout bands covered by the layout band n
+		constexpr int getFirstBand(int n) const { return n == 0 ? 0 : crossovers[n - 1] + 1; }
+		constexpr int getLastBand(int n) const { return n == bandCount - 1 ? CossackConstants::bandCount - 1 : crossovers[n]; }
+	};
+
+	static constexpr BandLayout bandLayouts[]{
+		{ 10, { 0, 1, 2, 3, 4, 5, 6, 7, 8 } },
+		{ 5, { 1, 3, 5, 7 } },
+		{ 4, { 1, 4, 7 } },
+		{ 3, { 2, 6 } }
+	};
+	static constexpr int bandLayoutCount = std::size(bandLayouts);
+
+	static constexpr const BandLayout& getBandLayout(int count)
+	{
+		for (const auto& layout : bandLayouts)
+		{
+			if (layout.bandCount == count)
+				return layout;
+		}
+
+		return bandLayouts[0];
+	}
 };
\ No newline at end of file
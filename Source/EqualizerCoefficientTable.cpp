@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    EqualizerCoefficientTable.cpp
+    Created: 17 Oct 2026 10:21:06pm
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#include "EqualizerCoefficientTable.h"
+
+template<typename SampleType>
+void EqualizerCoefficientTable<SampleType>::prepare(double sampleRate)
+{
+	coefficients_.resize(bandCount * gainCount);
+
+	for (int band = 0; band < bandCount; band++)
+	{
+		for (int n = 0; n < gainCount; n++)
+		{
+			const auto gainDecibels = CossackConstants::equalizerGainMinimum + n * CossackConstants::equalizerGainStep;
+			design(coefficients_[band * gainCount + n], band, sampleRate, gainDecibels);
+		}
+	}
+}
+
+template<typename SampleType>
+const BiquadCoefficients<SampleType>& EqualizerCoefficientTable<SampleType>::getCoefficients(int band, float gainDecibels) const
+{
+	jassert(!coefficients_.empty());
+
+	const auto n = juce::jlimit(0, gainCount - 1, juce::roundToInt((gainDecibels - CossackConstants::equalizerGainMinimum) / CossackConstants::equalizerGainStep));
+
+	return coefficients_[band * gainCount + n];
+}
+
+template<typename SampleType>
+void EqualizerCoefficientTable<SampleType>::design(BiquadCoefficients<SampleType>& coefficients, int band, double sampleRate, float gainDecibels)
+{
+	//constexpr double inverseSqrt2 = static_cast<double> (0.70710678118654752440L);
+	const double inverseSqrt2 = 1.0 / juce::MathConstants<double>::sqrt2;
+	const double Q = 2.0;
+
+	const double frequency = CossackConstants::bandFrequencies[band];
+	const double gain = juce::Decibels::decibelsToGain(static_cast<double>(gainDecibels));
+
+	if (band == 0)
+		coefficients.setLowShelf(sampleRate, frequency, inverseSqrt2, gain);
+	else if (band == bandCount - 1)
+		coefficients.setHighShelf(sampleRate, frequency, inverseSqrt2, gain);
+	else
+		coefficients.setPeak(sampleRate, frequency, Q, gain);
+}
+
+template class EqualizerCoefficientTable<float>;
+template class EqualizerCoefficientTable<double>;
@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    EqualizerCoefficientTable.h
+    Created: 17 Oct 2026 10:21:06pm
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "Common.h"
+#include "BiquadKernel.h"
+
+//
+// Every equalizer biquad the parameters can ask for, designed up front.
+// The band frequencies & Qs are fixed and the gains come in equalizerGainStep steps,
+// so a band's coefficients are a lookup instead of a design.
+//
+template<typename SampleType>
+class EqualizerCoefficientTable
+{
+public:
+	static constexpr int bandCount = CossackConstants::bandCount;
+	static constexpr int gainCount = static_cast<int>((CossackConstants::equalizerGainMaximum - CossackConstants::equalizerGainMinimum) / CossackConstants::equalizerGainStep + 0.5f) + 1;
+
+	// Designs the whole table for the sample rate
+	void prepare(double sampleRate);
+
+	// Coefficients of the band at the nearest gain step
+	const BiquadCoefficients<SampleType>& getCoefficients(int band, float gainDecibels) const;
+
+	// Shelves at the ends, peaks in between
+	static void design(BiquadCoefficients<SampleType>& coefficients, int band, double sampleRate, float gainDecibels);
+
+private:
+	// gainCount per band
+	std::vector<BiquadCoefficients<SampleType>> coefficients_;
+};
@@ -0,0 +1,268 @@
+/*
+  ==============================================================================
+
+    LinearPhaseCutProcessor.cpp
+    Created: 18 Oct 2026 1:36:52am
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#include "LinearPhaseCutProcessor.h"
+
+template<typename SampleType>
+LinearPhaseCutProcessor<SampleType>::LinearPhaseCutProcessor(float cutoffFrequency, int order, bool isHighCut, double filterLengthSeconds) :
+	isHighCut_(isHighCut),
+	filterLengthSeconds_(filterLengthSeconds),
+	sampleRate_(0.0),
+	channelCount_(0),
+	filterLength_(0),
+	partitionSize_(0),
+	partitionCount_(0),
+	binCount_(0),
+	cutoffFrequency_(cutoffFrequency),
+	order_(order),
+	isEnabled_(true),
+	designed_{ 0.f, 0, false },
+	activeSpectra_(0),
+	ready_(false),
+	fifoPosition_(0),
+	spectraPosition_(0)
+{
+	jassert(cutoffFrequency > 0.f);
+	jassert(order > 0);
+}
+
+template<typename SampleType>
+void LinearPhaseCutProcessor<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+{
+	const juce::ScopedLock lock(designLock_);
+
+	sampleRate_ = spec.sampleRate;
+	channelCount_ = spec.numChannels;
+
+	// Partitions as large as the blocks, fewer partitions are cheaper
+	filterLength_ = static_cast<size_t>(juce::nextPowerOfTwo(static_cast<int>(sampleRate_ * filterLengthSeconds_)));
+	partitionSize_ = juce::jmin(static_cast<size_t>(juce::nextPowerOfTwo(juce::jmax(static_cast<int>(spec.maximumBlockSize), minimumPartitionSize))), filterLength_ / 2);
+	partitionCount_ = filterLength_ / partitionSize_;
+	binCount_ = partitionSize_ + 1;
+
+	// Partitions are zero padded to twice the length for the overlap-save
+	fft_ = std::make_unique<juce::dsp::FFT>(juce::roundToInt(std::log2(partitionSize_ * 2)));
+	designFFT_ = std::make_unique<juce::dsp::FFT>(juce::roundToInt(std::log2(filterLength_)));
+	partitionFFT_ = std::make_unique<juce::dsp::FFT>(juce::roundToInt(std::log2(partitionSize_ * 2)));
+
+	for (auto& spectra : spectra_)
+		spectra.assign(partitionCount_ * binCount_, Complex());
+
+	inputBuffer_.assign(channelCount_ * partitionSize_ * 2, 0.f);
+	inputSpectra_.assign(channelCount_ * partitionCount_ * binCount_, Complex());
+	outputBuffer_.assign(channelCount_ * partitionSize_, 0.f);
+
+	fftBuffer_.assign(partitionSize_ * 4, 0.f);
+	designBuffer_.assign(filterLength_ * 2, 0.f);
+	impulse_.assign(filterLength_, 0.f);
+	accumulator_.assign(binCount_, Complex());
+
+	// Design straight into the active spectra, nothing is pending after this
+	activeSpectra_ = 0;
+	ready_ = false;
+	designFilter(activeSpectra_, getRequestedDesign());
+
+	reset();
+}
+
+template<typename SampleType>
+void LinearPhaseCutProcessor<SampleType>::process(const juce::dsp::AudioBlock<SampleType>& block)
+{
+	jassert(block.getNumChannels() == channelCount_);
+
+	// Pick up the new design, if any
+	if (ready_.load(std::memory_order_acquire))
+	{
+		activeSpectra_ = 1 - activeSpectra_;
+		ready_.store(false, std::memory_order_release);
+	}
+
+	const auto numSamples = block.getNumSamples();
+
+	for (size_t done = 0; done < numSamples;)
+	{
+		const auto count = juce::jmin(numSamples - done, partitionSize_ - fifoPosition_);
+
+		// Input goes into the current partition, output comes from the previous one
+		for (size_t ch = 0; ch < channelCount_; ch++)
+		{
+			auto* samples = block.getChannelPointer(ch) + done;
+			auto* partition = inputBuffer_.data() + ch * partitionSize_ * 2 + partitionSize_ + fifoPosition_;
+			const auto* output = outputBuffer_.data() + ch * partitionSize_ + fifoPosition_;
+
+			for (size_t j = 0; j < count; j++)
+			{
+				partition[j] = static_cast<float>(samples[j]);
+				samples[j] = static_cast<SampleType>(output[j]);
+			}
+		}
+
+		fifoPosition_ += count;
+		done += count;
+
+		if (fifoPosition_ == partitionSize_)
+		{
+			processPartition();
+			fifoPosition_ = 0;
+		}
+	}
+}
+
+template<typename SampleType>
+void LinearPhaseCutProcessor<SampleType>::processPartition()
+{
+	const auto& spectra = spectra_[activeSpectra_];
+
+	spectraPosition_ = (spectraPosition_ + partitionCount_ - 1) % partitionCount_;
+
+	for (size_t ch = 0; ch < channelCount_; ch++)
+	{
+		auto* input = inputBuffer_.data() + ch * partitionSize_ * 2;
+		auto* channelSpectra = inputSpectra_.data() + ch * partitionCount_ * binCount_;
+
+		std::copy(input, input + partitionSize_ * 2, fftBuffer_.begin());
+		fft_->performRealOnlyForwardTransform(fftBuffer_.data(), true);
+
+		const auto* bins = reinterpret_cast<const Complex*>(fftBuffer_.data());
+		std::copy(bins, bins + binCount_, channelSpectra + spectraPosition_ * binCount_);
+
+		// Current partition becomes the previous one
+		std::copy(input + partitionSize_, input + partitionSize_ * 2, input);
+
+		std::fill(accumulator_.begin(), accumulator_.end(), Complex());
+
+		// Filter partition p meets the input from p partitions ago
+		for (size_t p = 0; p < partitionCount_; p++)
+		{
+			const auto* x = channelSpectra + ((spectraPosition_ + p) % partitionCount_) * binCount_;
+			const auto* h = spectra.data() + p * binCount_;
+
+			for (size_t b = 0; b < binCount_; b++)
+				accumulator_[b] += x[b] * h[b];
+		}
+
+		auto* result = reinterpret_cast<Complex*>(fftBuffer_.data());
+		std::copy(accumulator_.begin(), accumulator_.end(), result);
+		fft_->performRealOnlyInverseTransform(fftBuffer_.data());
+
+		// Overlap-save, the second half is free of the circular wrap
+		std::copy(fftBuffer_.data() + partitionSize_, fftBuffer_.data() + partitionSize_ * 2, outputBuffer_.data() + ch * partitionSize_);
+	}
+}
+
+template<typename SampleType>
+void LinearPhaseCutProcessor<SampleType>::designFilter(int buffer, const Design& design)
+{
+	auto& spectra = spectra_[buffer];
+	auto* bins = reinterpret_cast<Complex*>(designBuffer_.data());
+	const auto halfLength = filterLength_ / 2;
+
+	// Zero phase Butterworth magnitude response, flat when disabled
+	for (size_t b = 0; b <= halfLength; b++)
+	{
+		const auto frequency = static_cast<float>(b * sampleRate_ / filterLength_);
+		auto magnitude = 1.f;
+
+		if (design.isEnabled)
+		{
+			const auto ratio = isHighCut_ ? frequency / design.cutoffFrequency : design.cutoffFrequency / juce::jmax(frequency, 0.001f);
+			magnitude = 1.f / std::sqrt(1.f + std::pow(ratio, 2.f * design.order));
+		}
+
+		bins[b] = magnitude;
+	}
+
+	designFFT_->performRealOnlyInverseTransform(designBuffer_.data());
+
+	// Center the impulse response & taper its ends.
+	// The window is 1 at the center, so the disabled cut is still a pure delay.
+	for (size_t n = 0; n < filterLength_; n++)
+	{
+		const auto window = std::pow(std::sin(juce::MathConstants<float>::pi * n / filterLength_), 2.f);
+		impulse_[n] = designBuffer_[(n + halfLength) % filterLength_] * window;
+	}
+
+	// Cut into the partitions
+	for (size_t p = 0; p < partitionCount_; p++)
+	{
+		std::fill(designBuffer_.begin(), designBuffer_.end(), 0.f);
+		std::copy(impulse_.begin() + p * partitionSize_, impulse_.begin() + (p + 1) * partitionSize_, designBuffer_.begin());
+
+		partitionFFT_->performRealOnlyForwardTransform(designBuffer_.data(), true);
+
+		std::copy(bins, bins + binCount_, spectra.begin() + p * binCount_);
+	}
+
+	designed_ = design;
+}
+
+template<typename SampleType>
+void LinearPhaseCutProcessor<SampleType>::designInBackground()
+{
+	const juce::ScopedTryLock lock(designLock_);
+
+	// Not prepared yet, or the last design hasn't been picked up
+	if (!lock.isLocked() || fft_ == nullptr || ready_.load(std::memory_order_acquire))
+		return;
+
+	const auto design = getRequestedDesign();
+
+	if (design.cutoffFrequency == designed_.cutoffFrequency && design.order == designed_.order && design.isEnabled == designed_.isEnabled)
+		return;
+
+	designFilter(1 - activeSpectra_, design);
+	ready_.store(true, std::memory_order_release);
+}
+
+template<typename SampleType>
+typename LinearPhaseCutProcessor<SampleType>::Design LinearPhaseCutProcessor<SampleType>::getRequestedDesign() const
+{
+	return { cutoffFrequency_.load(), order_.load(), isEnabled_.load() };
+}
+
+template<typename SampleType>
+void LinearPhaseCutProcessor<SampleType>::reset()
+{
+	std::fill(inputBuffer_.begin(), inputBuffer_.end(), 0.f);
+	std::fill(inputSpectra_.begin(), inputSpectra_.end(), Complex());
+	std::fill(outputBuffer_.begin(), outputBuffer_.end(), 0.f);
+
+	fifoPosition_ = 0;
+	spectraPosition_ = 0;
+}
+
+template<typename SampleType>
+void LinearPhaseCutProcessor<SampleType>::setCutoffFrequency(float f)
+{
+	cutoffFrequency_ = f;
+}
+
+template<typename SampleType>
+void LinearPhaseCutProcessor<SampleType>::setOrder(int order)
+{
+	jassert(order > 0);
+
+	order_ = order;
+}
+
+template<typename SampleType>
+void LinearPhaseCutProcessor<SampleType>::setEnabled(bool b)
+{
+	isEnabled_ = b;
+}
+
+template<typename SampleType>
+int LinearPhaseCutProcessor<SampleType>::getLatency() const
+{
+	return static_cast<int>(partitionSize_ + filterLength_ / 2);
+}
+
+template class LinearPhaseCutProcessor<float>;
+template class LinearPhaseCutProcessor<double>;
@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    LinearPhaseCutProcessor.h
+    Created: 18 Oct 2026 1:36:52am
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <complex>
+#include <vector>
+#include "BackgroundDesigner.h"
+
+//
+// Linear phase low/high cut, an FIR with the Butterworth magnitude response
+// run by uniformly partitioned FFT convolution (overlap-save).
+//
+// A disabled cut is designed as a pure delay, so the latency stays the same whether it's on or not.
+// New settings are designed on the BackgroundDesigner thread & swapped in at the start of a block.
+//
+// The FFT only comes in float, double samples are converted on the way.
+//
+template<typename SampleType>
+class LinearPhaseCutProcessor : public BackgroundDesigner::Client
+{
+public:
+	// The filter has to be long enough to resolve the slope at the cutoff
+	LinearPhaseCutProcessor(float cutoffFrequency, int order, bool isHighCut, double filterLengthSeconds);
+
+	// Allocates & designs the filter for the current settings right away
+	void prepare(const juce::dsp::ProcessSpec& spec);
+
+	// As many channels as prepared
+	void process(const juce::dsp::AudioBlock<SampleType>& block);
+
+	void reset();
+
+	// Safe to call from the audio thread, the filter follows once redesigned
+	void setCutoffFrequency(float);
+	void setOrder(int);
+	void setEnabled(bool);
+
+	// Fixed once prepared: the partition buffering plus the delay of the filter
+	int getLatency() const;
+
+	void designInBackground() override;
+
+private:
+	using Complex = std::complex<float>;
+
+	static constexpr int minimumPartitionSize = 256;
+
+	struct Design
+	{
+		float cutoffFrequency;
+		int order;
+		bool isEnabled;
+	};
+
+	Design getRequestedDesign() const;
+
+	// Design the filter into the given spectra buffer
+	void designFilter(int buffer, const Design& design);
+
+	// Convolve the partition that has just been filled
+	void processPartition();
+
+	// Guards the designs against prepare()
+	juce::CriticalSection designLock_;
+
+	const bool isHighCut_;
+	const double filterLengthSeconds_;
+
+	double sampleRate_;
+	size_t channelCount_;
+
+	// Filter length, partition length & number of filter partitions
+	size_t filterLength_;
+	size_t partitionSize_;
+	size_t partitionCount_;
+	size_t binCount_;
+
+	// The convolution's, only ever used on the audio thread
+	std::unique_ptr<juce::dsp::FFT> fft_;
+
+	// The design's own, the whole filter & a partition of it. An FFT can't be shared between threads.
+	std::unique_ptr<juce::dsp::FFT> designFFT_;
+	std::unique_ptr<juce::dsp::FFT> partitionFFT_;
+
+	// Requested by the audio thread & the ones the spectra were last designed for
+	std::atomic<float> cutoffFrequency_;
+	std::atomic<int> order_;
+	std::atomic<bool> isEnabled_;
+	Design designed_;
+
+	// Partitioned filter spectra, partitionCount * binCount, double buffered.
+	// The designer only writes the inactive one, and only while ready_ isn't set.
+	std::vector<Complex> spectra_[2];
+	int activeSpectra_;
+	std::atomic<bool> ready_;
+
+	// Last two partitions of the input per channel, the current one being filled
+	std::vector<float> inputBuffer_;
+	size_t fifoPosition_;
+
+	// Spectra of the past input partitions per channel, newest at spectraPosition_
+	std::vector<Complex> inputSpectra_;
+	size_t spectraPosition_;
+
+	// Output of the last partition per channel
+	std::vector<float> outputBuffer_;
+
+	std::vector<float> fftBuffer_;
+	std::vector<float> designBuffer_;
+	std::vector<float> impulse_;
+	std::vector<Complex> accumulator_;
+};
@@ -0,0 +1,419 @@
+/*
+  ==============================================================================
+
+    LinearPhaseFilterBank.cpp
+    Created: 17 Oct 2026 7:58:03pm
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#include "LinearPhaseFilterBank.h"
+#include "Common.h"
+
+template<typename SampleType, int BandCount>
+LinearPhaseFilterBank<SampleType, BandCount>::LinearPhaseFilterBank() :
+	sampleRate_(0.0),
+	channelCount_(0),
+	filterLength_(0),
+	partitionSize_(0),
+	partitionCount_(0),
+	binCount_(0),
+	activeSpectra_(0),
+	ready_(false),
+	fading_(false),
+	enabled_(false),
+	hasSpectra_(false),
+	fifoPosition_(0),
+	spectraPosition_(0)
+{
+	const auto& layout = CossackConstants::getBandLayout(BandCount);
+
+	for (int i = 0; i < crossoverCount; i++)
+	{
+		frequencies_[i] = CossackConstants::crossoverFrequencies[layout.crossovers[i]];
+		designedFrequencies_[i] = 0.f;
+	}
+}
+
+template<typename SampleType, int BandCount>
+void LinearPhaseFilterBank<SampleType, BandCount>::prepare(const juce::dsp::ProcessSpec& spec)
+{
+	const juce::ScopedLock lock(designLock_);
+
+	sampleRate_ = spec.sampleRate;
+	channelCount_ = spec.numChannels;
+
+	// Partitions as large as the blocks, fewer partitions are cheaper
+	filterLength_ = static_cast<size_t>(juce::nextPowerOfTwo(static_cast<int>(sampleRate_ * filterLengthSeconds)));
+	partitionSize_ = juce::jmin(static_cast<size_t>(juce::nextPowerOfTwo(juce::jmax(static_cast<int>(spec.maximumBlockSize), minimumPartitionSize))), filterLength_ / 2);
+	partitionCount_ = filterLength_ / partitionSize_;
+	binCount_ = partitionSize_ + 1;
+
+	// Partitions are zero padded to twice the length for the overlap-save
+	fft_ = std::make_unique<juce::dsp::FFT>(juce::roundToInt(std::log2(partitionSize_ * 2)));
+	designFFT_ = std::make_unique<juce::dsp::FFT>(juce::roundToInt(std::log2(filterLength_)));
+	partitionFFT_ = std::make_unique<juce::dsp::FFT>(juce::roundToInt(std::log2(partitionSize_ * 2)));
+
+	inputBuffer_.assign(channelCount_ * partitionSize_ * 2, 0.f);
+	inputSpectra_.assign(channelCount_ * partitionCount_ * binCount_, Complex());
+	outputBuffer_.assign(bandCount * channelCount_ * partitionSize_, 0.f);
+
+	fftBuffer_.assign(partitionSize_ * 4, 0.f);
+	fadeBuffer_.assign(partitionSize_, 0.f);
+	designBuffer_.assign(filterLength_ * 2, 0.f);
+	accumulator_.assign(binCount_, Complex());
+
+	// Design straight into the active spectra, nothing is pending after this
+	activeSpectra_ = 0;
+	ready_ = false;
+	fading_ = false;
+
+	if (enabled_)
+	{
+		float frequencies[crossoverCount];
+
+		for (int i = 0; i < crossoverCount; i++)
+			frequencies[i] = frequencies_[i];
+
+		for (auto& spectra : spectra_)
+			spectra.assign(bandCount * partitionCount_ * binCount_, Complex());
+
+		designFilters(spectra_[activeSpectra_], frequencies);
+		hasSpectra_ = true;
+	}
+	else
+	{
+		for (auto& spectra : spectra_)
+			spectra = std::vector<Complex>();
+
+		hasSpectra_ = false;
+	}
+
+	reset();
+}
+
+template<typename SampleType, int BandCount>
+void LinearPhaseFilterBank<SampleType, BandCount>::setEnabled(bool isEnabled)
+{
+	enabled_ = isEnabled;
+}
+
+template<typename SampleType, int BandCount>
+bool LinearPhaseFilterBank<SampleType, BandCount>::isReady() const
+{
+	// Held by the designer only while it frees the spectra
+	const juce::SpinLock::ScopedTryLockType lock(storageLock_);
+
+	return lock.isLocked() && enabled_ && hasSpectra_;
+}
+
+template<typename SampleType, int BandCount>
+void LinearPhaseFilterBank<SampleType, BandCount>::process(const juce::dsp::AudioBlock<const SampleType>& input, const juce::dsp::AudioBlock<SampleType>* bands, const bool* muted)
+{
+	jassert(input.getNumChannels() == channelCount_);
+	jassert(hasSpectra_);
+
+	// Pick up the new design, if any. The old one is kept until the next partition fades out of it.
+	if (!fading_ && ready_.load(std::memory_order_acquire))
+	{
+		activeSpectra_ = 1 - activeSpectra_;
+		fading_ = true;
+	}
+
+	const auto numSamples = input.getNumSamples();
+
+	for (size_t done = 0; done < numSamples;)
+	{
+		const auto count = juce::jmin(numSamples - done, partitionSize_ - fifoPosition_);
+
+		// Input goes into the current partition, output comes from the previous one
+		for (size_t ch = 0; ch < channelCount_; ch++)
+		{
+			const auto* inputSamples = input.getChannelPointer(ch) + done;
+			auto* partition = inputBuffer_.data() + ch * partitionSize_ * 2 + partitionSize_ + fifoPosition_;
+
+			for (size_t j = 0; j < count; j++)
+				partition[j] = static_cast<float>(inputSamples[j]);
+
+			for (int k = 0; k < bandCount; k++)
+			{
+				const auto* output = outputBuffer_.data() + (k * channelCount_ + ch) * partitionSize_ + fifoPosition_;
+				auto* bandSamples = bands[k].getChannelPointer(ch) + done;
+
+				for (size_t j = 0; j < count; j++)
+					bandSamples[j] = static_cast<SampleType>(output[j]);
+			}
+		}
+
+		fifoPosition_ += count;
+		done += count;
+
+		if (fifoPosition_ == partitionSize_)
+		{
+			processPartition(muted);
+			fifoPosition_ = 0;
+		}
+	}
+}
+
+template<typename SampleType, int BandCount>
+void LinearPhaseFilterBank<SampleType, BandCount>::processPartition(const bool* muted)
+{
+	const auto& spectra = spectra_[activeSpectra_];
+
+	spectraPosition_ = (spectraPosition_ + partitionCount_ - 1) % partitionCount_;
+
+	for (size_t ch = 0; ch < channelCount_; ch++)
+	{
+		auto* input = inputBuffer_.data() + ch * partitionSize_ * 2;
+		auto* channelSpectra = inputSpectra_.data() + ch * partitionCount_ * binCount_;
+
+		// The one forward transform, shared by all the bands
+		std::copy(input, input + partitionSize_ * 2, fftBuffer_.begin());
+		fft_->performRealOnlyForwardTransform(fftBuffer_.data(), true);
+
+		const auto* bins = reinterpret_cast<const Complex*>(fftBuffer_.data());
+		std::copy(bins, bins + binCount_, channelSpectra + spectraPosition_ * binCount_);
+
+		// Current partition becomes the previous one
+		std::copy(input + partitionSize_, input + partitionSize_ * 2, input);
+
+		for (int k = 0; k < bandCount; k++)
+		{
+			auto* output = outputBuffer_.data() + (k * channelCount_ + ch) * partitionSize_;
+
+			if (muted[k])
+			{
+				std::fill(output, output + partitionSize_, 0.f);
+				continue;
+			}
+
+			convolve(spectra, k, channelSpectra, output);
+
+			if (!fading_)
+				continue;
+
+			// Linear fade from the old filters' output to the new one's
+			convolve(spectra_[1 - activeSpectra_], k, channelSpectra, fadeBuffer_.data());
+
+			const auto scale = 1.f / static_cast<float>(partitionSize_);
+
+			for (size_t j = 0; j < partitionSize_; j++)
+				output[j] = fadeBuffer_[j] + (output[j] - fadeBuffer_[j]) * static_cast<float>(j + 1) * scale;
+		}
+	}
+
+	// The old spectra are free for the designer again
+	if (fading_)
+	{
+		fading_ = false;
+		ready_.store(false, std::memory_order_release);
+	}
+}
+
+template<typename SampleType, int BandCount>
+void LinearPhaseFilterBank<SampleType, BandCount>::convolve(const std::vector<Complex>& spectra, int k, const Complex* channelSpectra, float* output)
+{
+	std::fill(accumulator_.begin(), accumulator_.end(), Complex());
+
+	// Filter partition p meets the input from p partitions ago
+	for (size_t p = 0; p < partitionCount_; p++)
+	{
+		const auto* x = channelSpectra + ((spectraPosition_ + p) % partitionCount_) * binCount_;
+		const auto* h = spectra.data() + (k * partitionCount_ + p) * binCount_;
+
+		for (size_t b = 0; b < binCount_; b++)
+			accumulator_[b] += x[b] * h[b];
+	}
+
+	auto* result = reinterpret_cast<Complex*>(fftBuffer_.data());
+	std::copy(accumulator_.begin(), accumulator_.end(), result);
+	fft_->performRealOnlyInverseTransform(fftBuffer_.data());
+
+	// Overlap-save, the second half is free of the circular wrap
+	std::copy(fftBuffer_.data() + partitionSize_, fftBuffer_.data() + partitionSize_ * 2, output);
+}
+
+template<typename SampleType, int BandCount>
+void LinearPhaseFilterBank<SampleType, BandCount>::designFilters(std::vector<Complex>& spectra, const float* frequencies)
+{
+	auto* bins = reinterpret_cast<Complex*>(designBuffer_.data());
+	const auto halfLength = filterLength_ / 2;
+
+	for (int k = 0; k < bandCount; k++)
+	{
+		// Zero phase magnitude response, the difference of the neighbouring lowpasses
+		for (size_t b = 0; b <= halfLength; b++)
+		{
+			const auto frequency = static_cast<float>(b * sampleRate_ / filterLength_);
+
+			const auto lowpass = [&](int i)
+			{
+				if (i < 0)
+					return 0.f;
+
+				if (i >= crossoverCount)
+					return 1.f;
+
+				const auto ratio = frequency / frequencies[i];
+				const auto ratioSquared = ratio * ratio;
+
+				return 1.f / (1.f + ratioSquared * ratioSquared);
+			};
+
+			bins[b] = lowpass(k) - lowpass(k - 1);
+		}
+
+		designFFT_->performRealOnlyInverseTransform(designBuffer_.data());
+
+		// Center the impulse response & taper its ends.
+		// The window is 1 at the center, so the bands still add up to a pure delay.
+		std::vector<float> impulse(filterLength_);
+
+		for (size_t n = 0; n < filterLength_; n++)
+		{
+			const auto window = std::pow(std::sin(juce::MathConstants<float>::pi * n / filterLength_), 2.f);
+			impulse[n] = designBuffer_[(n + halfLength) % filterLength_] * window;
+		}
+
+		// Cut into the partitions
+		for (size_t p = 0; p < partitionCount_; p++)
+		{
+			std::fill(designBuffer_.begin(), designBuffer_.end(), 0.f);
+			std::copy(impulse.begin() + p * partitionSize_, impulse.begin() + (p + 1) * partitionSize_, designBuffer_.begin());
+
+			partitionFFT_->performRealOnlyForwardTransform(designBuffer_.data(), true);
+
+			std::copy(bins, bins + binCount_, spectra.begin() + (k * partitionCount_ + p) * binCount_);
+		}
+	}
+
+	for (int i = 0; i < crossoverCount; i++)
+		designedFrequencies_[i] = frequencies[i];
+}
+
+template<typename SampleType, int BandCount>
+void LinearPhaseFilterBank<SampleType, BandCount>::designInBackground()
+{
+	const juce::ScopedTryLock lock(designLock_);
+
+	// Not prepared yet
+	if (!lock.isLocked() || fft_ == nullptr)
+		return;
+
+	if (!enabled_)
+	{
+		releaseSpectra();
+		return;
+	}
+
+	if (!hasSpectra_)
+	{
+		allocateSpectra();
+		return;
+	}
+
+	// The last design hasn't been faded in yet
+	if (ready_.load(std::memory_order_acquire))
+		return;
+
+	float frequencies[crossoverCount];
+	bool hasChanged = false;
+
+	for (int i = 0; i < crossoverCount; i++)
+	{
+		frequencies[i] = frequencies_[i];
+		hasChanged = hasChanged || frequencies[i] != designedFrequencies_[i];
+	}
+
+	if (!hasChanged)
+		return;
+
+	designFilters(spectra_[1 - activeSpectra_], frequencies);
+	ready_.store(true, std::memory_order_release);
+}
+
+template<typename SampleType, int BandCount>
+void LinearPhaseFilterBank<SampleType, BandCount>::allocateSpectra()
+{
+	// Allocated & designed aside, the audio thread doesn't touch the spectra until hasSpectra_ is set
+	std::vector<Complex> spectra[2];
+	float frequencies[crossoverCount];
+
+	for (int i = 0; i < crossoverCount; i++)
+		frequencies[i] = frequencies_[i];
+
+	for (auto& buffer : spectra)
+		buffer.assign(bandCount * partitionCount_ * binCount_, Complex());
+
+	designFilters(spectra[0], frequencies);
+
+	const juce::SpinLock::ScopedLockType lock(storageLock_);
+
+	for (int i = 0; i < 2; i++)
+		spectra_[i] = std::move(spectra[i]);
+
+	activeSpectra_ = 0;
+	ready_ = false;
+	fading_ = false;
+	hasSpectra_ = true;
+}
+
+template<typename SampleType, int BandCount>
+void LinearPhaseFilterBank<SampleType, BandCount>::releaseSpectra()
+{
+	if (!hasSpectra_)
+		return;
+
+	// Taken out under the lock, freed outside of it
+	std::vector<Complex> spectra[2];
+
+	{
+		const juce::SpinLock::ScopedLockType lock(storageLock_);
+
+		// Enabled again in the meantime, the audio thread may be using them
+		if (enabled_)
+			return;
+
+		for (int i = 0; i < 2; i++)
+			std::swap(spectra[i], spectra_[i]);
+
+		activeSpectra_ = 0;
+		ready_ = false;
+		fading_ = false;
+		hasSpectra_ = false;
+	}
+}
+
+template<typename SampleType, int BandCount>
+void LinearPhaseFilterBank<SampleType, BandCount>::reset()
+{
+	std::fill(inputBuffer_.begin(), inputBuffer_.end(), 0.f);
+	std::fill(inputSpectra_.begin(), inputSpectra_.end(), Complex());
+	std::fill(outputBuffer_.begin(), outputBuffer_.end(), 0.f);
+
+	fifoPosition_ = 0;
+	spectraPosition_ = 0;
+}
+
+template<typename SampleType, int BandCount>
+void LinearPhaseFilterBank<SampleType, BandCount>::setCrossoverFrequency(int n, SampleType frequency)
+{
+	frequencies_[n] = static_cast<float>(frequency);
+}
+
+template<typename SampleType, int BandCount>
+int LinearPhaseFilterBank<SampleType, BandCount>::getLatency() const
+{
+	return static_cast<int>(partitionSize_ + filterLength_ / 2);
+}
+
+template class LinearPhaseFilterBank<float, 10>;
+template class LinearPhaseFilterBank<float, 5>;
+template class LinearPhaseFilterBank<float, 4>;
+template class LinearPhaseFilterBank<float, 3>;
+template class LinearPhaseFilterBank<double, 10>;
+template class LinearPhaseFilterBank<double, 5>;
+template class LinearPhaseFilterBank<double, 4>;
+template class LinearPhaseFilterBank<double, 3>;
@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    LinearPhaseFilterBank.h
+    Created: 17 Oct 2026 7:58:03pm
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <complex>
+#include <vector>
+#include "BackgroundDesigner.h"
+
+//
+// Linear phase crossover, splits the signal into the bands with FIR filters
+// run by uniformly partitioned FFT convolution.
+//
+// Band k has the magnitude response of L(k) - L(k - 1), L(i) being the Linkwitz-Riley lowpass magnitude
+// at crossover i, so the bands add up to a pure delay of getLatency() samples.
+// One forward FFT per partition is shared by all the bands, each band then costs
+// a spectral multiply-add per filter partition & one inverse FFT.
+//
+// New crossover frequencies are designed on the BackgroundDesigner thread & picked up at the start of a block.
+// The next partition is convolved with both the old & the new filters & crossfaded, so automation doesn't click.
+// The filter spectra are only held while the bank is enabled, the designer allocates & frees them.
+//
+// The FFT only comes in float, double samples are converted on the way.
+//
+template<typename SampleType, int BandCount>
+class LinearPhaseFilterBank : public BackgroundDesigner::Client
+{
+public:
+	static constexpr int bandCount = BandCount;
+	static constexpr int crossoverCount = BandCount - 1;
+
+	LinearPhaseFilterBank();
+
+	// Allocates & designs the filters for the current crossover frequencies right away, if enabled
+	void prepare(const juce::dsp::ProcessSpec& spec);
+
+	// Audio thread only. Disabling lets the designer free the filters, enabling has it design them again.
+	void setEnabled(bool isEnabled);
+
+	// Audio thread only. Enabled with the filters designed, they stay until disabled.
+	bool isReady() const;
+
+	// Filter the input into the bands, one output block per band. Only while ready.
+	// Muted bands skip their part of the convolution & come out silent.
+	void process(const juce::dsp::AudioBlock<const SampleType>& input, const juce::dsp::AudioBlock<SampleType>* bands, const bool* muted);
+
+	void reset();
+
+	// Safe to call from the audio thread, the filters follow once redesigned
+	void setCrossoverFrequency(int n, SampleType frequency);
+
+	// Fixed once prepared: the partition buffering plus the delay of the filters
+	int getLatency() const;
+
+	void designInBackground() override;
+
+private:
+	using Complex = std::complex<float>;
+
+	// Long enough for a steep split at the lowest crossovers
+	static constexpr double filterLengthSeconds = 0.25;
+	static constexpr int minimumPartitionSize = 256;
+
+	// Design all the band filters into the given spectra buffer
+	void designFilters(std::vector<Complex>& spectra, const float* frequencies);
+
+	// Designer thread, following enabled_
+	void allocateSpectra();
+	void releaseSpectra();
+
+	// Convolve the partition that has just been filled
+	void processPartition(const bool* muted);
+
+	// Band k's filter over the input spectra of a channel, one partition of output
+	void convolve(const std::vector<Complex>& spectra, int k, const Complex* channelSpectra, float* output);
+
+	// Guards the designs against prepare()
+	juce::CriticalSection designLock_;
+
+	double sampleRate_;
+	size_t channelCount_;
+
+	// Filter length, partition length & number of filter partitions
+	size_t filterLength_;
+	size_t partitionSize_;
+	size_t partitionCount_;
+	size_t binCount_;
+
+	// The convolution's, only ever used on the audio thread
+	std::unique_ptr<juce::dsp::FFT> fft_;
+
+	// The designs' own, the whole filter & a partition of it. An FFT can't be shared between threads.
+	std::unique_ptr<juce::dsp::FFT> designFFT_;
+	std::unique_ptr<juce::dsp::FFT> partitionFFT_;
+
+	// Requested by the audio thread & the ones the spectra were last designed for
+	std::atomic<float> frequencies_[crossoverCount];
+	float designedFrequencies_[crossoverCount];
+
+	// Partitioned filter spectra, bandCount * partitionCount * binCount, double buffered.
+	// The designer only writes the inactive one, and only while ready_ isn't set.
+	// That stays set until the fade from the old spectra is done.
+	std::vector<Complex> spectra_[2];
+	int activeSpectra_;
+	std::atomic<bool> ready_;
+	bool fading_;
+
+	// Requested by the audio thread & whether spectra_ is allocated.
+	// The designer only frees the spectra while disabled, under storageLock_.
+	std::atomic<bool> enabled_;
+	std::atomic<bool> hasSpectra_;
+	mutable juce::SpinLock storageLock_;
+
+	// Last two partitions of the input per channel, the current one being filled
+	std::vector<float> inputBuffer_;
+	size_t fifoPosition_;
+
+	// Spectra of the past input partitions per channel, newest at spectraPosition_
+	std::vector<Complex> inputSpectra_;
+	size_t spectraPosition_;
+
+	// Output of the last partition per band & channel
+	std::vector<float> outputBuffer_;
+
+	std::vector<float> fftBuffer_;
+	std::vector<float> fadeBuffer_;
+	std::vector<float> designBuffer_;
+	std::vector<Complex> accumulator_;
+};
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    LinkwitzRileyKernel.h
+    Created: 17 Oct 2026 2:14:37pm
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//
+// Linkwitz-Riley crossover math, same TPT structure as in juce::dsp::LinkwitzRileyFilter,
+// but with the coefficients kept apart from the state.
+//
+// The state's VectorType is either a plain sample type (one state per channel)
+// or a juce::dsp::SIMDRegister (one channel per register lane).
+//
+
+template<typename NumericType>
+struct LinkwitzRileyCoefficients
+{
+	void setCutoffFrequency(double cutoffFrequency, double sampleRate)
+	{
+		// Keep away from Nyquist, where tan() blows up
+		cutoffFrequency = juce::jmin(cutoffFrequency, 0.49 * sampleRate);
+
+		g = static_cast<NumericType>(std::tan(juce::MathConstants<double>::pi * cutoffFrequency / sampleRate));
+		h = static_cast<NumericType>(1.0 / (1.0 + R2 * g + g * g));
+		R2plusG = R2 + g;
+	}
+
+	static constexpr NumericType R2 = juce::MathConstants<NumericType>::sqrt2;
+
+	NumericType g = 0;
+	NumericType h = 0;
+	NumericType R2plusG = 0;
+};
+
+template<typename VectorType>
+struct LinkwitzRileyState
+{
+	using NumericType = typename juce::dsp::SampleTypeHelpers::ElementType<VectorType>::Type;
+	using Coefficients = LinkwitzRileyCoefficients<NumericType>;
+
+	void reset()
+	{
+		s1 = s2 = s3 = s4 = VectorType(static_cast<NumericType>(0));
+	}
+
+	// Split the input into the low & high parts
+	// NOTE: Scalars always go on the right side of the operators, SIMDRegister only has those overloads.
+	inline void process(const Coefficients& c, VectorType x, VectorType& low, VectorType& high) noexcept
+	{
+		const VectorType yH = (x - s1 * c.R2plusG - s2) * c.h;
+
+		const VectorType yB = yH * c.g + s1;
+		s1 = yH * c.g + yB;
+
+		const VectorType yL = yB * c.g + s2;
+		s2 = yB * c.g + yL;
+
+		const VectorType yH2 = (yL - s3 * c.R2plusG - s4) * c.h;
+
+		const VectorType yB2 = yH2 * c.g + s3;
+		s3 = yH2 * c.g + yB2;
+
+		const VectorType yL2 = yB2 * c.g + s4;
+		s4 = yB2 * c.g + yL2;
+
+		low = yL2;
+		high = yL - yB * c.R2 + yH - yL2;
+	}
+
+	// Allpass with the same phase response as low + high, only uses the first half of the state
+	inline VectorType processAllpass(const Coefficients& c, VectorType x) noexcept
+	{
+		const VectorType yH = (x - s1 * c.R2plusG - s2) * c.h;
+
+		const VectorType yB = yH * c.g + s1;
+		s1 = yH * c.g + yB;
+
+		const VectorType yL = yB * c.g + s2;
+		s2 = yB * c.g + yL;
+
+		return yL - yB * c.R2 + yH;
+	}
+
+	VectorType s1, s2, s3, s4;
+};
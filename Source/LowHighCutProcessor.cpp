@@ -10,111 +10,202 @@
 
 #include "LowHighCutProcessor.h"
 
-LowHighCutProcessor::LowHighCutProcessor(float cutoffFrequency, int order, bool isHighCut) :
+template<typename SampleType>
+LowHighCutProcessor<SampleType>::LowHighCutProcessor(SampleType cutoffFrequency, int order, bool isHighCut) :
+	orders_{ order, order },
+	current_(0),
+	crossfadeLength_(0),
+	crossfadeRemaining_(0),
+	sampleRate_(0.0),
 	cutoffFrequency_(cutoffFrequency),
 	order_(order),
 	isHighCut_(isHighCut),
 	hasChanged_(true)
 {
 	jassert(cutoffFrequency_ >= 0);
-	jassert(order >= 0);
+	jassert(order_ > 0 && order_ <= maximumOrder);
 }
 
-LowHighCutProcessor::~LowHighCutProcessor()
+template<typename SampleType>
+void LowHighCutProcessor<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
 {
-}
+	sampleRate_ = spec.sampleRate;
 
-void LowHighCutProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
-{
-	if (hasChanged_)
+	for (auto& sections : sections_)
 	{
-		// Rebuild processor list
-		processors_.clear();
+		sections.setSmoothingTime(smoothingTime);
+		sections.prepare(spec);
+	}
 
-		// FIXME: Figure out if we need a setting for mono buffers to save performance
-		juce::dsp::ProcessSpec spec
-		{
-			sampleRate,
-			static_cast<juce::uint32> (samplesPerBlock),
-			//static_cast<juce::uint32> (juce::jmin(getTotalNumInputChannels(), getTotalNumOutputChannels()))
-			static_cast<juce::uint32> (juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels()))
-		};
+	scratch_ = juce::dsp::AudioBlock<SampleType>(memory_, spec.numChannels, spec.maximumBlockSize);
 
-		//pd->state = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, cutoffFrequency_);
-		//pd->state = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, cutoffFrequency_);
+	crossfadeLength_ = juce::jmax(1, juce::roundToInt(crossfadeTime * sampleRate_));
+	crossfadeRemaining_ = 0;
 
-		// KRIGS: (6 * order) dB/oct rolloff slope
-		auto filters = isHighCut_ ?
-			juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(cutoffFrequency_, sampleRate, order_) :
-			juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(cutoffFrequency_, sampleRate, order_);
+	// Right away at the current order, nothing to glide or fade from after prepare()
+	orders_[current_] = order_;
+	design(current_);
+	hasChanged_ = false;
+}
 
-		for (auto& filter : filters)
-		{
-			auto pd = std::make_shared<Duplicator>(filter);
-			pd->prepare(spec);
+template<typename SampleType>
+void LowHighCutProcessor<SampleType>::process(const juce::dsp::AudioBlock<SampleType>& block)
+{
+	jassert(block.getNumSamples() <= scratch_.getNumSamples());
 
-			processors_.push_back(pd);
-		}
+	if (hasChanged_)
+		update();
 
-		hasChanged_ = false;
-	}
-}
+	auto ioBlock = block;
 
-void LowHighCutProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiBuffer)
-{
-	if (processors_.empty())
+	if (crossfadeRemaining_ == 0)
+	{
+		sections_[current_].process(juce::dsp::ProcessContextReplacing<SampleType>(ioBlock));
 		return;
+	}
 
-	juce::dsp::AudioBlock<float> block(buffer);
-	juce::dsp::ProcessContextReplacing<float> context(block);
+	auto fadedOut = scratch_.getSubsetChannelBlock(0, block.getNumChannels()).getSubBlock(0, block.getNumSamples());
+	fadedOut.copyFrom(block);
 
-	for (auto& pd : processors_)
-		pd->process(context);
+	sections_[1 - current_].process(juce::dsp::ProcessContextReplacing<SampleType>(fadedOut));
+	sections_[current_].process(juce::dsp::ProcessContextReplacing<SampleType>(ioBlock));
 
-	/*
-	// KRIGS: simple low/high pass filter for test, 6 & 12 dB/oct
-	oneSampleBuffer_.resize(buffer.getNumChannels(), 0.f);
+	crossfade(block);
+}
 
-	const auto tan = tanf(juce::MathConstants<float>::pi * cutoffFrequency_ / sampleRate_);
-	const auto a1 = (tan - 1.f) / (tan + 1.f);
-	const auto sign = isHighCut_ ? 1.f : -1.f;
+template<typename SampleType>
+typename LowHighCutProcessor<SampleType>::Cascade* LowHighCutProcessor<SampleType>::getFusableCascade()
+{
+	if (hasChanged_)
+		update();
 
-	for (auto channel = 0; channel < buffer.getNumChannels(); channel++)
-	{
-		auto channelSamples = buffer.getWritePointer(channel);
+	return crossfadeRemaining_ == 0 ? &sections_[current_] : nullptr;
+}
 
-		for (auto i = 0; i < buffer.getNumSamples(); i++)
-		{
-			const auto inputSample = channelSamples[i];
+template<typename SampleType>
+void LowHighCutProcessor<SampleType>::crossfade(const juce::dsp::AudioBlock<SampleType>& block)
+{
+	const auto fadeLength = juce::jmin(block.getNumSamples(), static_cast<size_t>(crossfadeRemaining_));
+	const auto start = crossfadeLength_ - crossfadeRemaining_;
+	const auto scale = static_cast<SampleType>(1) / static_cast<SampleType>(crossfadeLength_);
 
-			const auto allPassFilteredSample = a1 * inputSample + oneSampleBuffer_[channel];
-			oneSampleBuffer_[channel] = inputSample - a1 * allPassFilteredSample;
+	for (size_t ch = 0; ch < block.getNumChannels(); ch++)
+	{
+		const auto* from = scratch_.getChannelPointer(ch);
+		auto* samples = block.getChannelPointer(ch);
 
-			channelSamples[i] = 0.5f * (inputSample + sign * allPassFilteredSample);
+		for (size_t j = 0; j < fadeLength; j++)
+		{
+			const auto gain = static_cast<SampleType>(start + static_cast<int>(j) + 1) * scale;
+			samples[j] = from[j] + (samples[j] - from[j]) * gain;
 		}
 	}
-	*/
-}
 
-void LowHighCutProcessor::reset()
-{
-	for (auto& pd : processors_)
-		pd->reset();
+	crossfadeRemaining_ -= static_cast<int>(fadeLength);
 }
 
-const juce::String LowHighCutProcessor::getName() const
+template<typename SampleType>
+void LowHighCutProcessor<SampleType>::reset()
 {
-	return "Low/High Cut";
+	// Finish the crossfade
+	crossfadeRemaining_ = 0;
+
+	for (auto& sections : sections_)
+		sections.reset();
 }
 
-void LowHighCutProcessor::setCutoffFrequency(float f)
+template<typename SampleType>
+void LowHighCutProcessor<SampleType>::setCutoffFrequency(SampleType f)
 {
+	hasChanged_ = hasChanged_ || f != cutoffFrequency_;
 	cutoffFrequency_ = f;
-	hasChanged_ = true;
 }
 
-void LowHighCutProcessor::setIsHighCut(bool b)
+template<typename SampleType>
+void LowHighCutProcessor<SampleType>::setIsHighCut(bool b)
 {
+	hasChanged_ = hasChanged_ || b != isHighCut_;
 	isHighCut_ = b;
-	hasChanged_ = true;
 }
+
+template<typename SampleType>
+void LowHighCutProcessor<SampleType>::setOrder(int order)
+{
+	jassert(order > 0 && order <= maximumOrder);
+
+	hasChanged_ = hasChanged_ || order != order_;
+	order_ = order;
+}
+
+template<typename SampleType>
+void LowHighCutProcessor<SampleType>::update()
+{
+	hasChanged_ = false;
+
+	if (orders_[current_] != order_)
+	{
+		if (crossfadeRemaining_ == 0)
+		{
+			// The other cascade starts from silence with the new order, its glides finished right away
+			current_ = 1 - current_;
+			orders_[current_] = order_;
+			design(current_);
+			sections_[current_].reset();
+
+			crossfadeRemaining_ = crossfadeLength_;
+			return;
+		}
+
+		// Try again once the crossfade is done
+		hasChanged_ = true;
+	}
+
+	design(current_);
+}
+
+template<typename SampleType>
+void LowHighCutProcessor<SampleType>::design(int cascade)
+{
+	// KRIGS: (6 * order) dB/oct rolloff slope
+	const auto pi = juce::MathConstants<double>::pi;
+	const auto frequency = static_cast<double>(cutoffFrequency_);
+	const auto order = orders_[cascade];
+	const auto pairCount = order / 2;
+
+	auto& sections = sections_[cascade];
+	BiquadCoefficients<SampleType> coefficients;
+	int n = 0;
+
+	for (int i = 0; i < pairCount; i++)
+	{
+		// Pole angles of the even & odd orders
+		const auto angle = order % 2 == 0 ?
+			(2 * i + 1) * pi / (2 * order) :
+			(i + 1) * pi / order;
+
+		const auto Q = 1.0 / (2.0 * std::cos(angle));
+
+		if (isHighCut_)
+			coefficients.setLowPass(sampleRate_, frequency, Q);
+		else
+			coefficients.setHighPass(sampleRate_, frequency, Q);
+
+		sections.setCoefficients(n++, coefficients);
+	}
+
+	// Real pole
+	if (order % 2 != 0)
+	{
+		if (isHighCut_)
+			coefficients.setFirstOrderLowPass(sampleRate_, frequency);
+		else
+			coefficients.setFirstOrderHighPass(sampleRate_, frequency);
+
+		sections.setCoefficients(n++, coefficients);
+	}
+
+	sections.setSectionCount(n);
+}
+
+template class LowHighCutProcessor<float>;
+template class LowHighCutProcessor<double>;
@@ -11,35 +11,76 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include <vector>
-#include "ProcessorBase.h"
+#include "BiquadCascade.h"
 
-class LowHighCutProcessor : public ProcessorBase
+//
+// Butterworth low/high cut, (6 * order) dB/oct.
+// The second order sections are designed in place into a fixed size cascade,
+// so the cut can be retuned from the audio thread without allocating.
+//
+// A new order is designed into a second cascade, which is crossfaded in
+// while the old one keeps running. Outside of the crossfade only one cascade runs.
+//
+template<typename SampleType>
+class LowHighCutProcessor
 {
 public:
-	LowHighCutProcessor(float cutoffFrequency = 2000.f, int order = 8, bool isHighCut = false);
-	~LowHighCutProcessor() override;
+	static constexpr int maximumOrder = 16;
 
-	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
+	using Cascade = BiquadCascade<SampleType, (maximumOrder + 1) / 2>;
 
-	void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+	LowHighCutProcessor(SampleType cutoffFrequency = 2000, int order = 8, bool isHighCut = false);
 
-	void reset() override;
+	void prepare(const juce::dsp::ProcessSpec& spec);
 
-	const juce::String getName() const override;
+	// As many channels as prepared, up to the prepared maximum block size
+	void process(const juce::dsp::AudioBlock<SampleType>& block);
 
-	void setCutoffFrequency(float);
+	// Applies the changes for the block & hands out the current cascade, for the caller to run it
+	// fused with others instead of process(). nullptr while crossfading, process() has to run then.
+	Cascade* getFusableCascade();
+
+	void reset();
+
+	// Safe to call from the audio thread, the sections are redesigned at the next process()
+	void setCutoffFrequency(SampleType);
 	void setIsHighCut(bool);
 
+	// Same, crossfades to the new order. One that comes during a crossfade waits for it to finish.
+	void setOrder(int);
+
 private:
-	using Filter = juce::dsp::IIR::Filter<float>;
-	using Coefficients = juce::dsp::IIR::Coefficients<float>;
-	using Duplicator = juce::dsp::ProcessorDuplicator<Filter, Coefficients>;
+	// Time the sections take to glide to a new cutoff
+	static constexpr double smoothingTime = 0.02;
+
+	// Time the cascades take to crossfade to a new order
+	static constexpr double crossfadeTime = 0.02;
+
+	// Butterworth poles into the given cascade at its order,
+	// one section per conjugate pair plus a first order one for the odd orders
+	void design(int cascade);
+
+	// Redesign the current cascade, start the crossfade to the new order when there's none going
+	void update();
+
+	// Fade from the other cascade's output in the scratch buffer to the block
+	void crossfade(const juce::dsp::AudioBlock<SampleType>& block);
+
+	// Current & the one faded out of, indexed by current_
+	Cascade sections_[2];
+	int orders_[2];
+	int current_;
+
+	// Output of the faded out cascade, maximum block size long per channel
+	juce::HeapBlock<char> memory_;
+	juce::dsp::AudioBlock<SampleType> scratch_;
+
+	int crossfadeLength_;
+	int crossfadeRemaining_;
 
-	//juce::dsp::ProcessorChain<Duplicator, Duplicator, Duplicator, Duplicator> processors_;
-	std::vector<std::shared_ptr<Duplicator>> processors_;
+	double sampleRate_;
 
-	float cutoffFrequency_;
+	SampleType cutoffFrequency_;
 	int order_;
 	bool isHighCut_;
 	bool hasChanged_;
@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    MidSideProcessor.cpp
+    Created: 18 Oct 2026 12:16:41am
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#include "MidSideProcessor.h"
+
+template<typename SampleType>
+MidSideProcessor<SampleType>::MidSideProcessor() :
+	blockSize_(0)
+{
+}
+
+template<typename SampleType>
+void MidSideProcessor<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+{
+	buffers_ = juce::dsp::AudioBlock<SampleType>(memory_, 2, spec.maximumBlockSize);
+	buffers_.clear();
+
+	blockSize_ = 0;
+}
+
+template<typename SampleType>
+void MidSideProcessor<SampleType>::split(const juce::dsp::AudioBlock<const SampleType>& input, SampleType stereoWidth, bool useMid, bool useSide)
+{
+	jassert(input.getNumSamples() <= buffers_.getNumSamples());
+
+	blockSize_ = input.getNumSamples();
+
+	auto* mid = buffers_.getChannelPointer(0);
+	auto* side = buffers_.getChannelPointer(1);
+
+	if (input.getNumChannels() < 2)
+	{
+		const auto* samples = input.getChannelPointer(0);
+
+		std::copy(samples, samples + blockSize_, mid);
+		std::fill(side, side + blockSize_, static_cast<SampleType>(0));
+
+		return;
+	}
+
+	// Widening keeps the loudest of the channels from clipping
+	const auto scale = static_cast<SampleType>(1) / juce::jmax(static_cast<SampleType>(1) + stereoWidth, static_cast<SampleType>(2));
+	const auto sideScale = scale * stereoWidth;
+
+	const auto* left = input.getChannelPointer(0);
+	const auto* right = input.getChannelPointer(1);
+
+	if (useMid && useSide)
+	{
+		for (size_t j = 0; j < blockSize_; j++)
+		{
+			mid[j] = (left[j] + right[j]) * scale;
+			side[j] = (left[j] - right[j]) * sideScale;
+		}
+	}
+	else if (useMid)
+	{
+		for (size_t j = 0; j < blockSize_; j++)
+			mid[j] = (left[j] + right[j]) * scale;
+	}
+	else if (useSide)
+	{
+		for (size_t j = 0; j < blockSize_; j++)
+			side[j] = (left[j] - right[j]) * sideScale;
+	}
+}
+
+template<typename SampleType>
+void MidSideProcessor<SampleType>::join(const juce::dsp::AudioBlock<SampleType>& output, bool useMid, bool useSide) const
+{
+	jassert(output.getNumSamples() == blockSize_);
+
+	const auto* mid = buffers_.getChannelPointer(0);
+	const auto* side = buffers_.getChannelPointer(1);
+
+	if (output.getNumChannels() < 2)
+	{
+		auto* samples = output.getChannelPointer(0);
+
+		if (useMid)
+			std::copy(mid, mid + blockSize_, samples);
+		else
+			std::fill(samples, samples + blockSize_, static_cast<SampleType>(0));
+
+		return;
+	}
+
+	auto* left = output.getChannelPointer(0);
+	auto* right = output.getChannelPointer(1);
+
+	if (useMid && useSide)
+	{
+		for (size_t j = 0; j < blockSize_; j++)
+		{
+			left[j] = mid[j] + side[j];
+			right[j] = mid[j] - side[j];
+		}
+	}
+	else if (useMid)
+	{
+		for (size_t j = 0; j < blockSize_; j++)
+			left[j] = right[j] = mid[j];
+	}
+	else if (useSide)
+	{
+		for (size_t j = 0; j < blockSize_; j++)
+		{
+			left[j] = side[j];
+			right[j] = -side[j];
+		}
+	}
+	else
+	{
+		output.clear();
+	}
+}
+
+template<typename SampleType>
+juce::dsp::AudioBlock<SampleType> MidSideProcessor<SampleType>::getMidBlock() const
+{
+	return buffers_.getSingleChannelBlock(0).getSubBlock(0, blockSize_);
+}
+
+template<typename SampleType>
+juce::dsp::AudioBlock<SampleType> MidSideProcessor<SampleType>::getSideBlock() const
+{
+	return buffers_.getSingleChannelBlock(1).getSubBlock(0, blockSize_);
+}
+
+template class MidSideProcessor<float>;
+template class MidSideProcessor<double>;
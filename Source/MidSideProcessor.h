@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    MidSideProcessor.h
+    Created: 18 Oct 2026 12:16:41am
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//
+// Mid/side split & join around the per-path processing, with the scratch buffers allocated up front.
+//
+// Mid & side are kept as one channel each. The right side channel is always the left one negated,
+// so it is rebuilt in the join instead of being processed twice.
+// Mono input goes to the mid only.
+//
+template<typename SampleType>
+class MidSideProcessor
+{
+public:
+	MidSideProcessor();
+
+	void prepare(const juce::dsp::ProcessSpec& spec);
+
+	// Encode the input into the mid & side buffers, widening the side by stereoWidth.
+	// Only the ones asked for are computed, the others are left as they were.
+	// The block can't be larger than the prepared maximum block size.
+	void split(const juce::dsp::AudioBlock<const SampleType>& input, SampleType stereoWidth, bool useMid, bool useSide);
+
+	// Decode back into the output, leaving out the mid or the side if asked to
+	void join(const juce::dsp::AudioBlock<SampleType>& output, bool useMid, bool useSide) const;
+
+	// Mono blocks of the current block's length, valid after split()
+	juce::dsp::AudioBlock<SampleType> getMidBlock() const;
+	juce::dsp::AudioBlock<SampleType> getSideBlock() const;
+
+private:
+	// Mid & side, maximum block size long
+	juce::HeapBlock<char> memory_;
+	juce::dsp::AudioBlock<SampleType> buffers_;
+
+	size_t blockSize_;
+};
@@ -1,156 +1,570 @@
 #include "PluginProcessor.h"
 
-template class MultiBandProcessor<float>;
-template class MultiBandProcessor<double>;
+template<typename SampleType, int BandCount>
+MultiBandProcessor<SampleType, BandCount>::MultiBandProcessor() :
+	sampleRate_(44100.0),
+	chunkSize_(0),
+	chunkCount_(0),
+	immediate_(false),
+#if JUCE_USE_SIMD
+	useSIMD_(false),
+#endif
+	linearPhase_(false),
+	channelCount_(0),
+	blockSize_(0)
+{
+	const auto& layout = CossackConstants::getBandLayout(BandCount);
+
+	for (int i = 0; i < crossoverCount; i++)
+		frequencies_[i].setCurrentAndTargetValue(static_cast<SampleType>(CossackConstants::crossoverFrequencies[layout.crossovers[i]]));
 
-template<typename SampleType>
-MultiBandProcessor<SampleType>::MultiBandProcessor()
+	std::fill(std::begin(muted_), std::end(muted_), false);
+}
+
+template<typename SampleType, int BandCount>
+void MultiBandProcessor<SampleType, BandCount>::prepare(const juce::dsp::ProcessSpec& spec)
 {
+	sampleRate_ = spec.sampleRate;
+
+	// Prepare the crossover filters, jumping straight to the last set frequencies.
+	// The allpass at crossover i has the same coefficients as the splitting filter.
+	for (int i = 0; i < crossoverCount; i++)
+	{
+		const auto frequency = frequencies_[i].getTargetValue();
+
+		frequencies_[i].reset(sampleRate_, crossoverGlideTime);
+		frequencies_[i].setCurrentAndTargetValue(frequency);
+
+		coefficients_[i].setCutoffFrequency(frequency, sampleRate_);
+	}
+
+	// Enough chunks for the largest block
+	chunkCoefficients_.resize((spec.maximumBlockSize / coefficientUpdateInterval + 1) * crossoverCount);
+
+	channelCount_ = spec.numChannels;
+
+	statesLHP_.resize(crossoverCount * channelCount_);
+	statesAP_.resize(allpassCount * channelCount_);
+
+#if JUCE_USE_SIMD
+	// Mono gains nothing from the lanes
+	useSIMD_ = channelCount_ > 1 && channelCount_ <= SIMDType::SIMDNumElements;
+#endif
+
+	// Allocate the band buffers
+	blockSize_ = 0;
+	bandBuffers_ = juce::dsp::AudioBlock<SampleType>(bandMemory_, bandCount * channelCount_, spec.maximumBlockSize);
+	bandBuffers_.clear();
+
+	for (auto& bandView : bandViews_)
+		bandView = {};
+
+	// Prepared regardless of the mode, so that switching over only has to wait for the filters
+	linearPhaseFilterBank_.prepare(spec);
+	linearPhase_ = linearPhaseFilterBank_.isReady();
+
+	reset();
 }
 
-template<typename SampleType>
-void MultiBandProcessor<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+template<typename SampleType, int BandCount>
+void MultiBandProcessor<SampleType, BandCount>::splitBlock(const juce::dsp::AudioBlock<const SampleType>& input, const juce::dsp::AudioBlock<SampleType>* bandOutputs)
 {
-	// Prepare the crossover filters
-	for (int i = 0; i < CossackConstants::crossoverCount; i++)
+	jassert(input.getNumChannels() == channelCount_);
+	jassert(input.getNumSamples() <= bandBuffers_.getNumSamples());
+
+	blockSize_ = input.getNumSamples();
+
+	for (int i = 0; i < bandCount; i++)
 	{
-		filtersLHP_[i].setCutoffFrequency(static_cast<SampleType>(CossackConstants::crossoverFrequencies[i]));
-		filtersLHP_[i].prepare(spec);
+		if (bandOutputs != nullptr && bandOutputs[i].getNumChannels() > 0)
+		{
+			jassert(bandOutputs[i].getNumChannels() == channelCount_ && bandOutputs[i].getNumSamples() == blockSize_);
 
-#ifdef PHASE_CORRECTION_IMMEDIATE
-		// FIXME: Make number of filters correct
-		for (int j = 0; j < CossackConstants::crossoverCount; j++)
+			bandViews_[i] = bandOutputs[i];
+		}
+		else
 		{
-			filtersAP_[i][j].setType(juce::dsp::LinkwitzRileyFilterType::allpass);
-			filtersAP_[i][j].setCutoffFrequency(static_cast<SampleType>(CossackConstants::crossoverFrequencies[i]));
-			filtersAP_[i][j].prepare(spec);
+			bandViews_[i] = bandBuffers_.getSubsetChannelBlock(static_cast<size_t>(i) * channelCount_, channelCount_).getSubBlock(0, blockSize_);
 		}
-#else
-		if (i > 0)
+	}
+
+	updateCoefficients();
+
+	if (linearPhase_)
+	{
+		linearPhaseFilterBank_.process(input, bandViews_, muted_);
+		return;
+	}
+
+#if JUCE_USE_SIMD
+	if (useSIMD_)
+	{
+		if (isTreeSplit())
+			splitBlockTreeSIMD(input);
+		else
+			splitBlockSIMD(input);
+	}
+	else
+#endif
+	{
+		if (isTreeSplit())
+			splitBlockTreeScalar(input);
+		else
+			splitBlockScalar(input);
+	}
+}
+
+template<typename SampleType, int BandCount>
+void MultiBandProcessor<SampleType, BandCount>::reconstructBlock(const juce::dsp::AudioBlock<SampleType>& output)
+{
+	jassert(output.getNumChannels() == channelCount_);
+	jassert(output.getNumSamples() == blockSize_);
+
+	if (areBandsAligned())
+	{
+		// Already compensated, simply sum everything up
+		output.clear();
+
+		for (int i = 0; i < bandCount; i++)
 		{
-			filtersAP_[i - 1].setType(juce::dsp::LinkwitzRileyFilterType::allpass);
-			filtersAP_[i - 1].setCutoffFrequency(static_cast<SampleType>(CossackConstants::crossoverFrequencies[i]));
-			filtersAP_[i - 1].prepare(spec);
+			if (!muted_[i])
+				output.add(getBandBuffer(i));
 		}
+
+		return;
+	}
+
+#if JUCE_USE_SIMD
+	if (useSIMD_)
+		reconstructBlockSIMD(output);
+	else
 #endif
+		reconstructBlockScalar(output);
+}
+
+template<typename SampleType, int BandCount>
+void MultiBandProcessor<SampleType, BandCount>::updateCoefficients()
+{
+	bool isGliding = false;
+
+	for (auto& frequency : frequencies_)
+		isGliding = isGliding || frequency.isSmoothing();
+
+	// Keep the whole block as one chunk unless we have to
+	chunkSize_ = isGliding ? coefficientUpdateInterval : juce::jmax(blockSize_, size_t(1));
+	chunkCount_ = (blockSize_ + chunkSize_ - 1) / chunkSize_;
+
+	for (size_t c = 0; c < chunkCount_; c++)
+	{
+		const auto length = static_cast<int>(juce::jmin(chunkSize_, blockSize_ - c * chunkSize_));
+		auto* chunkCoefficients = &chunkCoefficients_[c * crossoverCount];
+
+		for (int i = 0; i < crossoverCount; i++)
+		{
+			if (frequencies_[i].isSmoothing())
+				coefficients_[i].setCutoffFrequency(frequencies_[i].skip(length), sampleRate_);
+
+			chunkCoefficients[i] = coefficients_[i];
+		}
 	}
 }
 
-template<typename SampleType>
-void MultiBandProcessor<SampleType>::processSample(int ch, SampleType input)
+template<typename SampleType, int BandCount>
+const typename MultiBandProcessor<SampleType, BandCount>::Coefficients* MultiBandProcessor<SampleType, BandCount>::getChunkCoefficients(size_t chunk) const
+{
+	return &chunkCoefficients_[chunk * crossoverCount];
+}
+
+template<typename SampleType, int BandCount>
+void MultiBandProcessor<SampleType, BandCount>::splitBlockTreeScalar(const juce::dsp::AudioBlock<const SampleType>& input)
 {
-	//SampleType lp[CossackConstants::crossoverCount];
-	//SampleType hp[CossackConstants::crossoverCount];
+	// The whole signal starts out as the lowest band
+	getBandBuffer(0).copyFrom(input);
+
+	// Each node splits its input in place, the parents have already filled it by then
+	for (const auto& node : tree.nodes)
+	{
+		const auto low = getBandBuffer(node.first);
+		const auto high = getBandBuffer(node.crossover + 1);
+
+		for (size_t ch = 0; ch < channelCount_; ch++)
+		{
+			auto& state = statesLHP_[node.crossover * channelCount_ + ch];
+			auto* lowSamples = low.getChannelPointer(ch);
+			auto* highSamples = high.getChannelPointer(ch);
+
+			for (size_t c = 0, j = 0; c < chunkCount_; c++)
+			{
+				const auto& coefficients = getChunkCoefficients(c)[node.crossover];
+				const auto end = juce::jmin(j + chunkSize_, blockSize_);
+
+				for (; j < end; j++)
+					state.process(coefficients, lowSamples[j], lowSamples[j], highSamples[j]);
+			}
+
+			// Each half gets the phase shift of the crossovers in the other one
+			for (int i = node.first, k = node.allpassOffset; i < node.last; i++)
+			{
+				if (i == node.crossover)
+					continue;
+
+				auto& allpassState = statesAP_[k++ * channelCount_ + ch];
+				auto* samples = i > node.crossover ? lowSamples : highSamples;
+
+				for (size_t c = 0, j = 0; c < chunkCount_; c++)
+				{
+					const auto& coefficients = getChunkCoefficients(c)[i];
+					const auto end = juce::jmin(j + chunkSize_, blockSize_);
+
+					for (; j < end; j++)
+						samples[j] = allpassState.processAllpass(coefficients, samples[j]);
+				}
+			}
+		}
+	}
+}
 
-	bands_[0] = input;
+template<typename SampleType, int BandCount>
+void MultiBandProcessor<SampleType, BandCount>::splitBlockScalar(const juce::dsp::AudioBlock<const SampleType>& input)
+{
+	// The whole signal starts out as the lowest band
+	getBandBuffer(0).copyFrom(input);
 
 	// Go over the crossover frequencies.
 	// TODO: Each time, split off the high end of the unsplit signal.
 	// This way the lowest band gets the highest order filtering, which plays well with our hearing.
-	for (int i = 0; i < CossackConstants::crossoverCount; i++)
+	for (int i = 0; i < crossoverCount; i++)
 	{
-		// Split the current band
-		filtersLHP_[i].processSample(ch, bands_[i], bands_[i], bands_[i + 1]);
-		//filtersLHP_[i].processSample(ch, input, lp[i], hp[i]);
+		const auto low = getBandBuffer(i);
+		const auto high = getBandBuffer(i + 1);
+
+		for (size_t ch = 0; ch < channelCount_; ch++)
+		{
+			auto& state = statesLHP_[i * channelCount_ + ch];
+			auto* lowSamples = low.getChannelPointer(ch);
+			auto* highSamples = high.getChannelPointer(ch);
+
+			for (size_t c = 0, j = 0; c < chunkCount_; c++)
+			{
+				const auto& coefficients = getChunkCoefficients(c)[i];
+				const auto end = juce::jmin(j + chunkSize_, blockSize_);
+
+				for (; j < end; j++)
+					state.process(coefficients, lowSamples[j], lowSamples[j], highSamples[j]);
+			}
+		}
 	}
+}
 
-	//bands_[0] = lp[0] + hp[0];
+template<typename SampleType, int BandCount>
+void MultiBandProcessor<SampleType, BandCount>::reconstructBlockScalar(const juce::dsp::AudioBlock<SampleType>& output)
+{
+	int i;
 
-#ifdef PHASE_CORRECTION_IMMEDIATE
-	for (int i = 0; i < CossackConstants::crossoverCount - 1; i++)
+	// Formula is as follows:
+	// sum = b9 + b8 + ap8(b7 + ap7(b6 + ap6(b5 + ap5(b4 + ap4(b3 + ap3(b2 + ap2(b1 + ap1(b0))))))))
+	// Muted bands are zero, only the allpasses are left of their steps.
+	if (muted_[0])
+		output.clear();
+	else
+		output.copyFrom(getBandBuffer(0));
+
+	for (i = 1; i < crossoverCount; i++)
 	{
-		for (int j = i + 1; j < CossackConstants::crossoverCount; j++)
-			bands_[i] = filtersAP_[j][i].processSample(ch, bands_[i]);
+		const auto band = getBandBuffer(i);
+		const bool isSkipped = muted_[i];
+
+		for (size_t ch = 0; ch < channelCount_; ch++)
+		{
+			auto& state = statesAP_[(i - 1) * channelCount_ + ch];
+			auto* samples = output.getChannelPointer(ch);
+			const auto* bandSamples = band.getChannelPointer(ch);
+
+			for (size_t c = 0, j = 0; c < chunkCount_; c++)
+			{
+				const auto& coefficients = getChunkCoefficients(c)[i];
+				const auto end = juce::jmin(j + chunkSize_, blockSize_);
+
+				if (isSkipped)
+				{
+					for (; j < end; j++)
+						samples[j] = state.processAllpass(coefficients, samples[j]);
+				}
+				else
+				{
+					for (; j < end; j++)
+						samples[j] = bandSamples[j] + state.processAllpass(coefficients, samples[j]);
+				}
+			}
+		}
 	}
-#endif
 
-/*
-	return;
+	// Add the highest band (no compensation required)
+	if (!muted_[i])
+		output.add(getBandBuffer(i));
+}
 
-	//bands_[0] = filtersLP_[0].processSample(ch, bands_[0]);
-	//bands_[0] = filtersAP_[0].processSample(ch, bands_[0]);
+#if JUCE_USE_SIMD
+template<typename SampleType, int BandCount>
+void MultiBandProcessor<SampleType, BandCount>::splitBlockSIMD(const juce::dsp::AudioBlock<const SampleType>& input)
+{
+	const SampleType* inputSamples[SIMDType::SIMDNumElements];
+	SampleType* bandSamples[bandCount][SIMDType::SIMDNumElements];
 
-	SampleType lp, hp;
+	for (size_t ch = 0; ch < channelCount_; ch++)
+	{
+		inputSamples[ch] = input.getChannelPointer(ch);
 
-#if 1
-	//
-	// crossover 0
-	//
+		for (int i = 0; i < bandCount; i++)
+			bandSamples[i][ch] = getBandBuffer(i).getChannelPointer(ch);
+	}
 
-	// split
-	filtersLP_[0].processSample(ch, bands_[0], bands_[0], bands_[1]);
+	// Unused lanes stay at zero
+	alignas(SIMDType::SIMDRegisterSize) SampleType lanes[SIMDType::SIMDNumElements]{};
 
-	//
-	// crossover 1
-	//
+	for (size_t j = 0; j < blockSize_; j++)
+	{
+		const auto* coefficients = getChunkCoefficients(j / chunkSize_);
 
-	// split
-	filtersLP_[1].processSample(ch, bands_[1], bands_[1], bands_[2]);
+		for (size_t ch = 0; ch < channelCount_; ch++)
+			lanes[ch] = inputSamples[ch][j];
 
-	// compensate the low band's phase shift
-	bands_[0] = filtersAP_[1].processSample(ch, bands_[0]);
-#else
-	filtersLP_[0].processSample(ch, input, bands_[0], hp);
+		// Peel the bands off one by one, all the channels advance together
+		auto high = SIMDType::fromRawArray(lanes);
+		SIMDType low;
 
-	filtersLP_[1].processSample(ch, input, lp, bands_[2]);
+		for (int i = 0; i < crossoverCount; i++)
+		{
+			simdStatesLHP_[i].process(coefficients[i], high, low, high);
 
-	bands_[1] = input - bands_[0] - bands_[2];
-#endif
-*/
+			low.copyToRawArray(lanes);
+
+			for (size_t ch = 0; ch < channelCount_; ch++)
+				bandSamples[i][ch][j] = lanes[ch];
+		}
+
+		high.copyToRawArray(lanes);
+
+		for (size_t ch = 0; ch < channelCount_; ch++)
+			bandSamples[crossoverCount][ch][j] = lanes[ch];
+	}
 }
 
-template<typename SampleType>
-SampleType MultiBandProcessor<SampleType>::reconstructSample(int ch)
+template<typename SampleType, int BandCount>
+void MultiBandProcessor<SampleType, BandCount>::splitBlockTreeSIMD(const juce::dsp::AudioBlock<const SampleType>& input)
 {
-	int i;
-	SampleType sum;
+	const SampleType* inputSamples[SIMDType::SIMDNumElements];
+	SampleType* bandSamples[bandCount][SIMDType::SIMDNumElements];
 
-#ifdef PHASE_CORRECTION_IMMEDIATE
-	sum = 0.0;
+	for (size_t ch = 0; ch < channelCount_; ch++)
+	{
+		inputSamples[ch] = input.getChannelPointer(ch);
 
-	for (i = 0; i < CossackConstants::bandCount; i++)
-		sum += bands_[i];
+		for (int i = 0; i < bandCount; i++)
+			bandSamples[i][ch] = getBandBuffer(i).getChannelPointer(ch);
+	}
 
-#else
-	// Formula is as follows:
-	// sum = b9 + b8 + ap8(b7 + ap7(b6 + ap6(b5 + ap5(b4 + ap4(b3 + ap3(b2 + ap2(b1 + ap1(b0))))))))
-	sum = bands_[0];
+	alignas(SIMDType::SIMDRegisterSize) SampleType lanes[SIMDType::SIMDNumElements]{};
 
-	for (i = 1; i < CossackConstants::crossoverCount; i++)
-		sum = bands_[i] + filtersAP_[i - 1].processSample(ch, sum);
+	for (size_t j = 0; j < blockSize_; j++)
+	{
+		const auto* coefficients = getChunkCoefficients(j / chunkSize_);
 
-	// Add the highest band (no compensation required)
-	sum += bands_[i];
+		for (size_t ch = 0; ch < channelCount_; ch++)
+			lanes[ch] = inputSamples[ch][j];
+
+		// Same as in splitBlockTreeScalar(), a sample at a time
+		SIMDType bands[bandCount];
+		bands[0] = SIMDType::fromRawArray(lanes);
+
+		for (const auto& node : tree.nodes)
+		{
+			SIMDType low, high;
+			simdStatesLHP_[node.crossover].process(coefficients[node.crossover], bands[node.first], low, high);
+
+			for (int i = node.first, k = node.allpassOffset; i < node.last; i++)
+			{
+				if (i > node.crossover)
+					low = simdStatesAP_[k++].processAllpass(coefficients[i], low);
+				else if (i < node.crossover)
+					high = simdStatesAP_[k++].processAllpass(coefficients[i], high);
+			}
+
+			bands[node.first] = low;
+			bands[node.crossover + 1] = high;
+		}
+
+		for (int i = 0; i < bandCount; i++)
+		{
+			bands[i].copyToRawArray(lanes);
+
+			for (size_t ch = 0; ch < channelCount_; ch++)
+				bandSamples[i][ch][j] = lanes[ch];
+		}
+	}
+}
+
+template<typename SampleType, int BandCount>
+void MultiBandProcessor<SampleType, BandCount>::reconstructBlockSIMD(const juce::dsp::AudioBlock<SampleType>& output)
+{
+	SampleType* outputSamples[SIMDType::SIMDNumElements];
+	const SampleType* bandSamples[bandCount][SIMDType::SIMDNumElements];
+
+	for (size_t ch = 0; ch < channelCount_; ch++)
+	{
+		outputSamples[ch] = output.getChannelPointer(ch);
+
+		for (int i = 0; i < bandCount; i++)
+			bandSamples[i][ch] = getBandBuffer(i).getChannelPointer(ch);
+	}
+
+	alignas(SIMDType::SIMDRegisterSize) SampleType lanes[SIMDType::SIMDNumElements]{};
+
+	const auto loadBand = [&](int i, size_t j)
+	{
+		for (size_t ch = 0; ch < channelCount_; ch++)
+			lanes[ch] = bandSamples[i][ch][j];
+
+		return SIMDType::fromRawArray(lanes);
+	};
+
+	for (size_t j = 0; j < blockSize_; j++)
+	{
+		const auto* coefficients = getChunkCoefficients(j / chunkSize_);
+
+		// Same formula as in reconstructBlockScalar()
+		auto sum = muted_[0] ? SIMDType::expand(static_cast<SampleType>(0)) : loadBand(0, j);
+
+		for (int i = 1; i < crossoverCount; i++)
+		{
+			sum = simdStatesAP_[i - 1].processAllpass(coefficients[i], sum);
+
+			if (!muted_[i])
+				sum = sum + loadBand(i, j);
+		}
+
+		if (!muted_[crossoverCount])
+			sum = sum + loadBand(crossoverCount, j);
+
+		sum.copyToRawArray(lanes);
+
+		for (size_t ch = 0; ch < channelCount_; ch++)
+			outputSamples[ch][j] = lanes[ch];
+	}
+}
 #endif
 
-	return sum;
+template<typename SampleType, int BandCount>
+void MultiBandProcessor<SampleType, BandCount>::reset()
+{
+	for (auto& state : statesLHP_)
+		state.reset();
+
+	for (auto& state : statesAP_)
+		state.reset();
+
+#if JUCE_USE_SIMD
+	for (auto& state : simdStatesLHP_)
+		state.reset();
+
+	for (auto& state : simdStatesAP_)
+		state.reset();
+#endif
+
+	linearPhaseFilterBank_.reset();
+}
+
+template<typename SampleType, int BandCount>
+void MultiBandProcessor<SampleType, BandCount>::setCrossoverFrequency(int n, SampleType frequency)
+{
+	frequencies_[n].setTargetValue(frequency);
+	linearPhaseFilterBank_.setCrossoverFrequency(n, frequency);
 }
 
-template<typename SampleType>
-void MultiBandProcessor<SampleType>::reset()
+template<typename SampleType, int BandCount>
+void MultiBandProcessor<SampleType, BandCount>::setLinearPhase(bool isLinearPhase)
 {
-	for (int i = 0; i < CossackConstants::crossoverCount; i++) {
-		filtersLHP_[i].reset();
+	linearPhaseFilterBank_.setEnabled(isLinearPhase);
+
+	const bool linearPhase = isLinearPhase && linearPhaseFilterBank_.isReady();
 
-#ifdef PHASE_CORRECTION_IMMEDIATE
-		// FIXME: Make number of filters correct
-		for (int j = 0; j < CossackConstants::crossoverCount; j++)
-			filtersAP_[i][j].reset();
+	if (linearPhase_ != linearPhase)
+	{
+		linearPhase_ = linearPhase;
+		reset();
+	}
+}
+
+template<typename SampleType, int BandCount>
+bool MultiBandProcessor<SampleType, BandCount>::isLinearPhase() const
+{
+	return linearPhase_;
+}
+
+template<typename SampleType, int BandCount>
+void MultiBandProcessor<SampleType, BandCount>::setImmediatePhaseCorrection(bool isImmediate)
+{
+	if (immediate_ != isImmediate)
+	{
+		immediate_ = isImmediate;
+		reset();
+	}
+}
+
+template<typename SampleType, int BandCount>
+bool MultiBandProcessor<SampleType, BandCount>::areBandsAligned() const
+{
+	return linearPhase_ || isTreeSplit();
+}
+
+template<typename SampleType, int BandCount>
+void MultiBandProcessor<SampleType, BandCount>::setBandMuted(int n, bool isMuted)
+{
+	muted_[n] = isMuted;
+}
+
+template<typename SampleType, int BandCount>
+bool MultiBandProcessor<SampleType, BandCount>::isTreeSplit() const
+{
+#ifdef SPLIT_TOPOLOGY_TREE
+	return true;
 #else
-		if (i > 0)
-			filtersAP_[i - 1].reset();
+	return immediate_;
 #endif
-	}
 }
 
-template<typename SampleType>
-SampleType& MultiBandProcessor<SampleType>::getBand(int n)
+template<typename SampleType, int BandCount>
+int MultiBandProcessor<SampleType, BandCount>::getLatency() const
 {
-	return bands_[n];
+	if (linearPhase_)
+		return linearPhaseFilterBank_.getLatency();
+
+	return 0;
 }
 
-template<typename SampleType>
-SampleType* MultiBandProcessor<SampleType>::getBandsPointer()
+template<typename SampleType, int BandCount>
+void MultiBandProcessor<SampleType, BandCount>::designInBackground()
 {
-	return &bands_[0];
+	linearPhaseFilterBank_.designInBackground();
 }
+
+template<typename SampleType, int BandCount>
+juce::dsp::AudioBlock<SampleType> MultiBandProcessor<SampleType, BandCount>::getBandBlock(int n) const
+{
+	return getBandBuffer(n);
+}
+
+template<typename SampleType, int BandCount>
+const juce::dsp::AudioBlock<SampleType>& MultiBandProcessor<SampleType, BandCount>::getBandBuffer(int n) const
+{
+	return bandViews_[n];
+}
+
+template class MultiBandProcessor<float, 10>;
+template class MultiBandProcessor<float, 5>;
+template class MultiBandProcessor<float, 4>;
+template class MultiBandProcessor<float, 3>;
+template class MultiBandProcessor<double, 10>;
+template class MultiBandProcessor<double, 5>;
+template class MultiBandProcessor<double, 4>;
+template class MultiBandProcessor<double, 3>;
@@ -1,57 +1,212 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
+#include <vector>
 #include "PluginProcessor.h"
+#include "LinkwitzRileyKernel.h"
+#include "LinearPhaseFilterBank.h"
+#include "BackgroundDesigner.h"
 
 //
 // Splits the incoming signal into multiple bands
 //
-// TODO: Adjustable crossover frequencies
+// BandCount has to match one of the layouts in CossackConstants::bandLayouts,
+// crossover n of the processor is crossover bandLayouts[...].crossovers[n] of the full layout.
 //
 
-// Uncomment to do phase compensation right after the multi-band split.
-// Much slower due to having triangular complexity of the filter number increase.
+// Uncomment to always split with a balanced tree of crossovers instead of a chain going up from the lowest band.
+// The longest chain of filters a sample goes through is then about log2 of the band count,
+// at the cost of n * log2(n) compensation allpasses instead of n.
 //
-// Allows sending data of the separate bands outside.
-//
-// Keep commented to instead do compensation at the end, in reconstructSample(),
-// reducing complexity to linear.
-//#define PHASE_CORRECTION_IMMEDIATE
+// Each half of a split gets the phase shift of the other half's crossovers right away,
+// so the bands come out aligned and the reconstruction is a plain sum.
+// Without it, the tree split is only used for the immediate phase correction.
+//#define SPLIT_TOPOLOGY_TREE
+
+// Crossovers of the tree split in the processing order, parents before their children.
+// A node's compensation allpasses are shared by all the bands split off further down.
+template<int CrossoverCount>
+struct CrossoverTree
+{
+	// Splits the bands first..last at the crossover, the input is in the band buffer first,
+	// the halves go to the band buffers first & crossover + 1
+	struct Node
+	{
+		int first;
+		int last;
+		int crossover;
+		// Compensation allpasses of the node, one per other crossover within first..last
+		int allpassOffset;
+	};
+
+	constexpr CrossoverTree()
+	{
+		addNodes(0, CrossoverCount, 0);
+	}
+
+	std::array<Node, CrossoverCount> nodes{};
+	int allpassCount = 0;
+
+private:
+	constexpr int addNodes(int first, int last, int n)
+	{
+		if (first == last)
+			return n;
+
+		// Middle one of the crossovers first..last - 1
+		const int crossover = (first + last - 1) / 2;
+
+		nodes[n] = { first, last, crossover, allpassCount };
+		allpassCount += last - first - 1;
+
+		n = addNodes(first, crossover, n + 1);
+		return addNodes(crossover + 1, last, n);
+	}
+};
 
-template<typename SampleType>
-class MultiBandProcessor
+template<typename SampleType, int BandCount>
+class MultiBandProcessor : public BackgroundDesigner::Client
 {
 public:
+	static constexpr int bandCount = BandCount;
+	static constexpr int crossoverCount = BandCount - 1;
+	// At least one compensation allpass
+	static_assert(crossoverCount >= 2);
+
 	MultiBandProcessor();
-	
+
 	void prepare(const juce::dsp::ProcessSpec &spec);
 
-	// Split the signal into bands
-	void processSample(int ch, SampleType input);
-	
-	// Join the bands back, applying phase compensation
-	SampleType reconstructSample(int ch);
-	
+	// Split a whole block into the preallocated band buffers.
+	// The block can't be larger than the prepared maximum block size.
+	//
+	// Optionally, bandOutputs holds a block per band, band n then goes straight into bandOutputs[n]
+	// instead of its own buffer, unless that block has no channels. They have to stay valid until reconstructBlock().
+	void splitBlock(const juce::dsp::AudioBlock<const SampleType>& input, const juce::dsp::AudioBlock<SampleType>* bandOutputs = nullptr);
+
+	// Join the band buffers back into the output block, applying phase compensation unless already done
+	void reconstructBlock(const juce::dsp::AudioBlock<SampleType>& output);
+
 	void reset();
 
-	// Get a singular band
-	SampleType& getBand(int n);
+	// Set the crossover's frequency, it will glide there over the next few blocks.
+	// Safe to call from the audio thread.
+	void setCrossoverFrequency(int n, SampleType frequency);
+
+	// Get a singular band's buffer, valid after splitBlock().
+	juce::dsp::AudioBlock<SampleType> getBandBlock(int n) const;
+
+	// Leave the band out of the reconstruction, as if it was silent.
+	// The caller can then skip its processing, the split still has to run it through the filters.
+	void setBandMuted(int n, bool isMuted);
 
-	// Get a pointer to all the bands
-	SampleType* getBandsPointer();
+	// Do the phase compensation right in the split, so that the bands come out aligned with each other.
+	// Needed whenever the bands are used on their own, or processed by anything nonlinear.
+	// Switches over to the tree split. Resets the processor.
+	void setImmediatePhaseCorrection(bool isImmediate);
+
+	// True if the bands add up without any further compensation: immediate correction, tree split or linear phase
+	bool areBandsAligned() const;
+
+	// Split with the linear phase FIR filter bank instead of the Linkwitz-Riley filters.
+	// Resets the processor, the delay of the whole signal changes to getLatency().
+	//
+	// The filters are only held while requested. Turned on, the split lags behind
+	// with the Linkwitz-Riley filters until the designer has them ready, call again each block.
+	// Set before prepare() to have them designed right away.
+	void setLinearPhase(bool isLinearPhase);
+	bool isLinearPhase() const;
+
+	// Delay added by the processing, in samples
+	int getLatency() const;
+
+	// Redesigns the linear phase filters after the crossover frequencies change
+	void designInBackground() override;
 
 private:
-	// Splitting filters
-	juce::dsp::LinkwitzRileyFilter<SampleType> filtersLHP_[CossackConstants::crossoverCount];
-
-	// Phase compensation filters
-#ifdef PHASE_CORRECTION_IMMEDIATE
-	// FIXME: Make number of filters correct
-	juce::dsp::LinkwitzRileyFilter<SampleType> filtersAP_[CossackConstants::crossoverCount][CossackConstants::crossoverCount];
-#else
-	juce::dsp::LinkwitzRileyFilter<SampleType> filtersAP_[CossackConstants::crossoverCount - 1];
+	using Coefficients = LinkwitzRileyCoefficients<SampleType>;
+	using State = LinkwitzRileyState<SampleType>;
+
+	// Coefficients are recalculated this often while the crossover frequencies glide
+	static constexpr size_t coefficientUpdateInterval = 32;
+	static constexpr double crossoverGlideTime = 0.05;
+
+	// Advance the crossover frequencies over the block, filling chunkCoefficients_
+	void updateCoefficients();
+
+	// Coefficients of the crossovers for the given chunk of the current block
+	const Coefficients* getChunkCoefficients(size_t chunk) const;
+
+	// Where band n goes in the current block
+	const juce::dsp::AudioBlock<SampleType>& getBandBuffer(int n) const;
+
+	// Tree split in use, either from the immediate correction or SPLIT_TOPOLOGY_TREE
+	bool isTreeSplit() const;
+
+	// One channel at a time, each filter runs over the whole block
+	void splitBlockScalar(const juce::dsp::AudioBlock<const SampleType>& input);
+	void splitBlockTreeScalar(const juce::dsp::AudioBlock<const SampleType>& input);
+	void reconstructBlockScalar(const juce::dsp::AudioBlock<SampleType>& output);
+
+#if JUCE_USE_SIMD
+	using SIMDType = juce::dsp::SIMDRegister<SampleType>;
+	using SIMDState = LinkwitzRileyState<SIMDType>;
+
+	// All channels at once, packed into the register lanes
+	void splitBlockSIMD(const juce::dsp::AudioBlock<const SampleType>& input);
+	void splitBlockTreeSIMD(const juce::dsp::AudioBlock<const SampleType>& input);
+	void reconstructBlockSIMD(const juce::dsp::AudioBlock<SampleType>& output);
 #endif
 
-	SampleType bands_[CossackConstants::bandCount];
-};
+	double sampleRate_;
+
+	// Crossover frequencies & the resulting coefficients,
+	// shared by the splitting and phase compensation filters of the same frequency
+	juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Multiplicative> frequencies_[crossoverCount];
+	Coefficients coefficients_[crossoverCount];
+
+	// Coefficients for each chunk of the current block, so that the split and the reconstruction see the same ones.
+	// The block is a single chunk unless some frequency is gliding.
+	std::vector<Coefficients> chunkCoefficients_;
+	size_t chunkSize_;
+	size_t chunkCount_;
+
+	// Splitting filters, crossoverCount * channelCount
+	std::vector<State> statesLHP_;
 
+	// Phase compensation filters, channelCount per filter.
+	// The chain split uses the first crossoverCount - 1 of them in the reconstruction, the tree split all of them.
+	static constexpr CrossoverTree<crossoverCount> tree{};
+	static constexpr int allpassCount = tree.allpassCount;
+	static_assert(allpassCount >= crossoverCount - 1);
+	std::vector<State> statesAP_;
+
+	// Immediate phase correction
+	bool immediate_;
+
+#if JUCE_USE_SIMD
+	// Same as above, for the SIMD path
+	SIMDState simdStatesLHP_[crossoverCount];
+	SIMDState simdStatesAP_[allpassCount];
+
+	// Set in prepare(), when all the channels fit into the lanes
+	bool useSIMD_;
+#endif
+
+	// Band buffers for the block processing, bandCount * channelCount channels long
+	juce::HeapBlock<char> bandMemory_;
+	juce::dsp::AudioBlock<SampleType> bandBuffers_;
+
+	// Where the bands of the current block go, either the band buffers or the outputs passed to splitBlock()
+	juce::dsp::AudioBlock<SampleType> bandViews_[bandCount];
+
+	bool muted_[bandCount];
+
+	// Linear phase mode, the bands simply add up in the reconstruction
+	bool linearPhase_;
+	LinearPhaseFilterBank<SampleType, BandCount> linearPhaseFilterBank_;
+
+	size_t channelCount_;
+	size_t blockSize_;
+};
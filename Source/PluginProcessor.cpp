@@ -13,24 +13,22 @@
 CossackAudioProcessor::CossackAudioProcessor()
 	:
 #ifndef JucePlugin_PreferredChannelConfigurations
-	AudioProcessor(BusesProperties()
-#if ! JucePlugin_IsMidiEffect
-#if ! JucePlugin_IsSynth
-		.withInput("Input", juce::AudioChannelSet::stereo(), true)
-#endif
-		.withOutput("Output", juce::AudioChannelSet::stereo(), true)
-#endif
-	),
+	AudioProcessor(createBusesProperties()),
 #else
 #endif
+	valueTreeState_(*this, nullptr, juce::Identifier("CossackParameters"), createParameterLayout()),
+	sampleRate_(0.0),
 	parameters_{ 0 },
-	lowCutProcessor_{
-		{ 30.f, 8 },
-		{ 100.f, 2 }
-	},
-	highCutProcessor_{ 20000.f, 8, true },
+	bandLayout_(0),
+	fadedBandLayout_(0),
+	bandLayoutFadeLength_(0),
+	bandLayoutFadeRemaining_(0),
+	equalizerMode_(EqualizerMode::crossover),
+	linearPhaseCuts_(false),
+	harmonicsAntialiasing_(HarmonicsAntialiasing::oversampling),
+	harmonics_{ false, false },
+	midSideRouting_(0)
 	//convolution_{ juce::dsp::Convolution::NonUniform{ 1024 } },
-	valueTreeState_(*this, nullptr, juce::Identifier("CossackParameters"), createParameterLayout())
 {
 	//
 	// Get the parameters
@@ -39,6 +37,9 @@ CossackAudioProcessor::CossackAudioProcessor()
 	// Low/high cut
 	parameters_.lowCut = static_cast<juce::AudioParameterBool*>(valueTreeState_.getParameter("lowCut"));
 	parameters_.highCut = static_cast<juce::AudioParameterBool*>(valueTreeState_.getParameter("highCut"));
+	parameters_.lowCutSlope = static_cast<juce::AudioParameterChoice*>(valueTreeState_.getParameter("lowCutSlope"));
+	parameters_.highCutSlope = static_cast<juce::AudioParameterChoice*>(valueTreeState_.getParameter("highCutSlope"));
+	parameters_.linearPhaseCuts = static_cast<juce::AudioParameterBool*>(valueTreeState_.getParameter("linearPhaseCuts"));
 
 	// Mid/side
 	parameters_.mid = static_cast<juce::AudioParameterBool*>(valueTreeState_.getParameter("mid"));
@@ -53,6 +54,8 @@ CossackAudioProcessor::CossackAudioProcessor()
 			const juce::String index = std::to_string(i) + "_" + std::to_string(j);
 			parameters_.equalizers[i][j] = static_cast<juce::AudioParameterFloat*>(valueTreeState_.getParameter("equalizer" + index));
 			valueTreeState_.addParameterListener(parameters_.equalizers[i][j]->getParameterID(), this);
+
+			equalizerChanged_[i][j] = true;
 		}
 
 		// Harmonics
@@ -62,6 +65,35 @@ CossackAudioProcessor::CossackAudioProcessor()
 			parameters_.harmonicsSide[j - 2] = static_cast<juce::AudioParameterBool*>(valueTreeState_.getParameter("harmonicsSide" + std::to_string(j)));
 	}
 
+	parameters_.equalizerSmoothing = static_cast<juce::AudioParameterFloat*>(valueTreeState_.getParameter("equalizerSmoothing"));
+	parameters_.equalizerMode = static_cast<juce::AudioParameterChoice*>(valueTreeState_.getParameter("equalizerMode"));
+
+	// Multi-band split
+	parameters_.bandLayout = static_cast<juce::AudioParameterChoice*>(valueTreeState_.getParameter("bandLayout"));
+
+	for (int i = 0; i < CossackConstants::crossoverCount; i++)
+		parameters_.crossovers[i] = static_cast<juce::AudioParameterFloat*>(valueTreeState_.getParameter("crossover" + std::to_string(i)));
+
+	parameters_.linearPhase = static_cast<juce::AudioParameterBool*>(valueTreeState_.getParameter("linearPhase"));
+	parameters_.immediatePhaseCorrection = static_cast<juce::AudioParameterBool*>(valueTreeState_.getParameter("immediatePhaseCorrection"));
+
+	std::apply([&](auto&... multiBand) { (backgroundDesigner_.addClient(&multiBand), ...); }, floatEngine_.multiBandProcessors);
+	std::apply([&](auto&... multiBand) { (backgroundDesigner_.addClient(&multiBand), ...); }, doubleEngine_.multiBandProcessors);
+
+	backgroundDesigner_.addClient(&floatEngine_.waveshaper);
+	backgroundDesigner_.addClient(&doubleEngine_.waveshaper);
+
+	for (int i = 0; i < 2; i++)
+	{
+		backgroundDesigner_.addClient(&floatEngine_.linearPhaseLowCuts[i]);
+		backgroundDesigner_.addClient(&floatEngine_.linearPhaseHighCuts[i]);
+		backgroundDesigner_.addClient(&doubleEngine_.linearPhaseLowCuts[i]);
+		backgroundDesigner_.addClient(&doubleEngine_.linearPhaseHighCuts[i]);
+	}
+
+	parameters_.harmonicsOversampling = static_cast<juce::AudioParameterChoice*>(valueTreeState_.getParameter("harmonicsOversampling"));
+	parameters_.harmonicsAntialiasing = static_cast<juce::AudioParameterChoice*>(valueTreeState_.getParameter("harmonicsAntialiasing"));
+
 	// Compressors
 	parameters_.opto = static_cast<juce::AudioParameterFloat*>(valueTreeState_.getParameter("opto"));
 	parameters_.glue = static_cast<juce::AudioParameterFloat*>(valueTreeState_.getParameter("glue"));
@@ -92,6 +124,25 @@ CossackAudioProcessor::~CossackAudioProcessor()
 {
 }
 
+juce::AudioProcessor::BusesProperties CossackAudioProcessor::createBusesProperties()
+{
+	BusesProperties buses;
+
+#if ! JucePlugin_IsMidiEffect
+#if ! JucePlugin_IsSynth
+	buses = buses.withInput("Input", juce::AudioChannelSet::stereo(), true);
+#endif
+	buses = buses.withOutput("Output", juce::AudioChannelSet::stereo(), true);
+
+	// Bands of the current layout, for processing them on separate tracks of the host.
+	// Bands past the layout's band count stay silent.
+	for (int i = 0; i < CossackConstants::bandCount; i++)
+		buses = buses.withOutput("Band " + juce::String(i + 1), juce::AudioChannelSet::stereo(), false);
+#endif
+
+	return buses;
+}
+
 //==============================================================================
 const juce::String CossackAudioProcessor::getName() const
 {
@@ -160,30 +211,31 @@ void CossackAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBloc
 	// Save this for later
 	sampleRate_ = sampleRate;
 
-	// Use this method as the place to do any pre-playback
-    // initialisation that you need...
-	for (int i = 0; i < 2; i++)
-		lowCutProcessor_[i].prepareToPlay(sampleRate_, samplesPerBlock);
+	// Everything is reset, no need to fade into the requested layout
+	bandLayout_ = parameters_.bandLayout->getIndex();
+	bandLayoutFadeLength_ = juce::jmax(1, juce::roundToInt(bandLayoutFadeTime * sampleRate_));
+	bandLayoutFadeRemaining_ = 0;
 
-	highCutProcessor_.prepareToPlay(sampleRate_, samplesPerBlock);
+	// Equalizer designs depend on it
+	for (auto& changed : equalizerChanged_)
+		for (auto& bandChanged : changed)
+			bandChanged = true;
 
 	// KRIGS: From JUCE docs...
 	// This method will return the total number of input channels by accumulating the number of channels on each input bus.
 	// The number of channels of the buffer passed to your processBlock callback will be equivalent
 	// to either getTotalNumInputChannels or getTotalNumOutputChannels - which ever is greater.
-	auto channelCount = static_cast<juce::uint32> (juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels()));
+	// The band outputs add to that, but everything here only ever runs on the main bus.
+	auto channelCount = static_cast<juce::uint32> (juce::jmax(getMainBusNumInputChannels(), getMainBusNumOutputChannels()));
 	juce::dsp::ProcessSpec spec{ sampleRate_, static_cast<juce::uint32> (samplesPerBlock), channelCount };
 
-	// Multi-band splitter
-	multiBandProcessor_.prepare(spec);
-
-	for (int i = 0; i < 2; i++) {
-		for (int j = 0; j < CossackConstants::bandCount; j++)
-			equalizerGains_[i][j].prepare(spec);
+	// Multi-band splitters & band gains, only for the precision the host asked for
+	if (isUsingDoublePrecision())
+		prepareEngine(doubleEngine_, spec);
+	else
+		prepareEngine(floatEngine_, spec);
 
-		// FIXME: Maybe a mono spec for the mid equalizer or mono input, and stereo spec for the side equalizer?
-		equalizerProcessors_[i].prepare(spec);
-	}
+	updateLatency();
 
 	// IR convolution for saturation/distortion
 	convolution_.prepare(spec);
@@ -216,6 +268,15 @@ bool CossackAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
         return false;
    #endif
 
+	// KRIGS: Band outputs are either off or the same as the main one
+	for (int i = 1; i < layouts.outputBuses.size(); i++)
+	{
+		const auto& bandOutput = layouts.getChannelSet(false, i);
+
+		if (!bandOutput.isDisabled() && bandOutput != layouts.getMainOutputChannelSet())
+			return false;
+	}
+
     return true;
   #endif
 }
@@ -243,10 +304,10 @@ template <typename T> int sgn(T val) {
 	return (T(0) < val) - (val < T(0));
 }
 
-float CossackAudioProcessor::testHarmonics(float x)
+float CossackAudioProcessor::testHarmonics(float x, float saturation)
 {
 	// Saturation coefficient
-	const float k = 1.f + 7.f * parameters_.glue->get();
+	const float k = 1.f + 7.f * saturation;
 
 	// Waveshaper type
 	const int type = 0;
@@ -383,318 +444,603 @@ float CossackAudioProcessor::testHarmonics(float x)
 	return 0.f;
 }
 
-void CossackAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+template<>
+CossackAudioProcessor::Engine<float>& CossackAudioProcessor::getEngine<float>()
 {
-    juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
+	return floatEngine_;
+}
 
-	// KRIGS: Same for everything
-	const int sampleCount = buffer.getNumSamples();
+template<>
+CossackAudioProcessor::Engine<double>& CossackAudioProcessor::getEngine<double>()
+{
+	return doubleEngine_;
+}
 
-	// In case we have more outputs than inputs, this code clears any output
-    // channels that didn't contain input data, (because these aren't
-    // guaranteed to be empty - they may contain garbage).
-    // This is here to avoid people getting screaming feedback
-    // when they first compile a plugin, but obviously you don't need to keep
-    // this code if your algorithm always overwrites all the output channels.
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear(i, 0, sampleCount);
+template<typename SampleType>
+void CossackAudioProcessor::prepareEngine(Engine<SampleType>& engine, const juce::dsp::ProcessSpec& spec)
+{
+	auto& multiBandProcessors = engine.multiBandProcessors;
 
-    // This is the place where you'd normally do the guts of your plugin's
-    // audio processing...
-    // Make sure to reset the state if your inner loop is processing
-    // the samples and the outer loop is handling the channels.
-    // Alternatively, you can process the samples with the channels
-    // interleaved by keeping the same state.
+	// The clients design in prepare() from whatever they were last given, so they get the parameters first.
+	// The equalizer designs come from the table, it goes by the new sample rate before that.
+	engine.equalizerTable.prepare(spec.sampleRate);
+	updateParameters<SampleType>();
 
-	// KRIGS: Update parameters & their dependencies
-	updateParameters();
+	// Only the current layout holds linear phase filters, they get designed in prepare()
+	for (int i = 0; i < CossackConstants::bandLayoutCount; i++)
+		withMultiBandProcessor<SampleType>(i, [&](auto& multiBand) { multiBand.setLinearPhase(parameters_.linearPhase->get() && i == bandLayout_); });
 
-	//
-	// Perform the processing
-	//
+	std::apply([&](auto&... multiBand) { (multiBand.prepare(spec), ...); }, multiBandProcessors);
+	std::apply([&](auto&... multiBand) { (multiBand.setImmediatePhaseCorrection(parameters_.immediatePhaseCorrection->get()), ...); }, multiBandProcessors);
 
-	if (totalNumInputChannels == 2) {
-		float* samples[] = { buffer.getWritePointer(0), buffer.getWritePointer(1) };
+	engine.bandGains.prepare(spec);
+	engine.fadedBandGains.prepare(spec);
+	engine.bandLayoutFadeBuffer = juce::dsp::AudioBlock<SampleType>(engine.bandLayoutFadeMemory, spec.numChannels, spec.maximumBlockSize);
 
-		for (int i = 0; i < sampleCount; i++) {
-			for (int j = 0; j < 2; j++) {
-				multiBandProcessor_.processSample(j, samples[j][i]);
+	// Mid & side are a channel each
+	engine.midSide.prepare(spec);
 
-				auto bands = multiBandProcessor_.getBandsPointer();
+	const juce::dsp::ProcessSpec pathSpec{ spec.sampleRate, spec.maximumBlockSize, 1 };
 
-				for (int k = 0; k < CossackConstants::bandCount; k++) {
-					bands[k] = float(parameters_.harmonicsMid[k]->get()) * equalizerGains_[0][k].processSample(bands[k]);
-				}
+	for (auto& equalizer : engine.equalizers)
+		equalizer.prepare(pathSpec);
 
-				samples[j][i] = multiBandProcessor_.reconstructSample(j);
-			}
-		}
+	for (auto& lowCut : engine.lowCuts)
+		lowCut.prepare(pathSpec);
+
+	for (auto& highCut : engine.highCuts)
+		highCut.prepare(pathSpec);
+
+	for (int i = 0; i < 2; i++)
+	{
+		engine.linearPhaseLowCuts[i].prepare(pathSpec);
+		engine.linearPhaseHighCuts[i].prepare(pathSpec);
+		engine.saturationOversamplers[i].prepare(pathSpec);
+		engine.antiderivativeWaveshapers[i].prepare(pathSpec);
 	}
 
-#if 0
-	const float harmonicsDrive = parameters_.opto->get();
+	engine.waveshaper.prepare(parameters_.glue->get());
+}
 
-	// Plugin settings should disallow number of input channels higher than 2
-	if (totalNumInputChannels == 2)
+template<typename SampleType, typename Function>
+void CossackAudioProcessor::withMultiBandProcessor(int bandLayout, Function&& function)
+{
+	auto& multiBandProcessors = getEngine<SampleType>().multiBandProcessors;
+	using MultiBandProcessors = std::remove_reference_t<decltype(multiBandProcessors)>;
+
+	static_assert(std::tuple_element_t<0, MultiBandProcessors>::bandCount == CossackConstants::bandLayouts[0].bandCount);
+	static_assert(std::tuple_element_t<1, MultiBandProcessors>::bandCount == CossackConstants::bandLayouts[1].bandCount);
+	static_assert(std::tuple_element_t<2, MultiBandProcessors>::bandCount == CossackConstants::bandLayouts[2].bandCount);
+	static_assert(std::tuple_element_t<3, MultiBandProcessors>::bandCount == CossackConstants::bandLayouts[3].bandCount);
+
+	switch (bandLayout)
 	{
-		// Stereo input.
-		// Do the mid/side split.
-		// Use values from separate mid/side controls for filtering.
+	case 0: function(std::get<0>(multiBandProcessors)); break;
+	case 1: function(std::get<1>(multiBandProcessors)); break;
+	case 2: function(std::get<2>(multiBandProcessors)); break;
+	case 3: function(std::get<3>(multiBandProcessors)); break;
+	default: jassertfalse; break;
+	}
+}
 
-		// TODO: Optimize the order of actions
-		float* samples[] = { buffer.getWritePointer(0), buffer.getWritePointer(1) };
+void CossackAudioProcessor::updateLatency()
+{
+	int latency = 0;
+	const auto getLatency = [&](auto& multiBand) { latency = multiBand.getLatency(); };
 
-		// Construct the buffers
-		//juce::AudioBuffer<float> midBuffer(1, sampleCount);
-		//float* midSamples = { midBuffer.getWritePointer(0) };
-		// Make it double channel for convenience
-		juce::AudioBuffer<float> midBuffer(2, sampleCount);
-		float* midSamples[] = { midBuffer.getWritePointer(0), midBuffer.getWritePointer(1) };
+	// The mid/side chain has the latency of the oversampling, or the whole sample of the second order antiderivatives while on,
+	// plus that of the cuts if they're linear phase
+	const auto getMidSideLatency = [&](auto& engine)
+	{
+		latency = engine.saturationOversamplers[0].getLatency();
 
-		juce::AudioBuffer<float> sideBuffer(2, sampleCount);
-		float* sideSamples[] = { sideBuffer.getWritePointer(0), sideBuffer.getWritePointer(1) };
+		if (harmonicsAntialiasing_ == HarmonicsAntialiasing::secondOrderAntiderivative && (harmonics_[0] || harmonics_[1]))
+			latency += 1;
 
-		//
-		// Mid/side split & stereo base expansion.
-		//
+		if (linearPhaseCuts_)
+			latency += engine.linearPhaseLowCuts[0].getLatency() + engine.linearPhaseHighCuts[0].getLatency();
+	};
 
-		constexpr float stereoWidth = 1.2f;
-		constexpr float scale = 1.f / juce::jmax(1.f + stereoWidth, 2.f);
+	if (equalizerMode_ == EqualizerMode::bell)
+	{
+		if (isUsingDoublePrecision())
+			getMidSideLatency(doubleEngine_);
+		else
+			getMidSideLatency(floatEngine_);
+	}
+	else if (isUsingDoublePrecision())
+		withMultiBandProcessor<double>(bandLayout_, getLatency);
+	else
+		withMultiBandProcessor<float>(bandLayout_, getLatency);
 
-		for (auto i = 0; i < sampleCount; i++)
-		{
-			//midSamples[i] = (samples[0][i] + samples[1][i]) * scale;
-			midSamples[0][i] = midSamples[1][i] = (samples[0][i] + samples[1][i]) * scale;
+	if (latency != getLatencySamples())
+		setLatencySamples(latency);
+}
 
-			//sideSamples[0][i] = (samples[0][i] - samples[1][i]) * scale * stereoWidth;
+template<typename SampleType, typename MultiBand>
+void CossackAudioProcessor::processBands(MultiBand& multiBand, BandGainProcessor<SampleType>& bandGains, const juce::dsp::AudioBlock<SampleType>& block, const juce::dsp::AudioBlock<SampleType>* bandOutputs, bool hasBandOutputs)
+{
+	const auto& layout = CossackConstants::getBandLayout(MultiBand::bandCount);
 
-			//sideSamples[0][i] = samples[0][i] * stereoWidth - midSamples[i];
-			//sideSamples[1][i] = samples[1][i] * stereoWidth - midSamples[i];
-			sideSamples[0][i] = (samples[0][i] - samples[1][i]) * scale * stereoWidth;
-			sideSamples[1][i] = (samples[1][i] - samples[0][i]) * scale * stereoWidth;
+	// These change the latency, the host is told right away
+	multiBand.setLinearPhase(parameters_.linearPhase->get());
+	// Bands sent out on their own have to be aligned
+	multiBand.setImmediatePhaseCorrection(parameters_.immediatePhaseCorrection->get() || hasBandOutputs);
+	updateLatency();
+
+	// Glides to the new frequencies by itself
+	for (int i = 0; i < MultiBand::crossoverCount; i++)
+		multiBand.setCrossoverFrequency(i, parameters_.crossovers[layout.crossovers[i]]->get());
+
+	// Classify the bands before the split, muted ones are left out of it where possible
+	float gains[MultiBand::bandCount];
+	bool isEnabled[MultiBand::bandCount];
+
+	for (int k = 0; k < MultiBand::bandCount; k++) {
+		// A band spanning several full layout bands takes their average gain, and is on if any of them is
+		const int firstBand = layout.getFirstBand(k);
+		const int lastBand = layout.getLastBand(k);
+
+		float gain = 0.f;
+		isEnabled[k] = false;
+
+		for (int n = firstBand; n <= lastBand; n++) {
+			gain += parameters_.equalizers[0][n]->get();
+			isEnabled[k] = isEnabled[k] || parameters_.harmonicsMid[n]->get();
 		}
 
-		// Bitfield for ease of usage
-		const char midSide = parameters_.mid->get() ? 1 : (parameters_.side->get() ? 2 : 3);
+		gains[k] = gain / float(lastBand - firstBand + 1);
+		multiBand.setBandMuted(k, !isEnabled[k]);
+	}
 
-		//
-		// Low cut, always comes first
-		//
+	multiBand.splitBlock(block, bandOutputs);
 
-		if (parameters_.lowCut->get())
-		{
-			if (midSide & 1)
-				lowCutProcessor_[0].processBlock(midBuffer, midiMessages);
+	for (int k = 0; k < MultiBand::bandCount; k++) {
+		auto band = multiBand.getBandBlock(k);
 
-			if (midSide & 2)
-				lowCutProcessor_[1].processBlock(sideBuffer, midiMessages);
+		// Muted bands don't make it into the reconstruction, only their outputs need silencing
+		if (!isEnabled[k]) {
+			if (bandOutputs != nullptr && bandOutputs[k].getNumChannels() > 0)
+				band.clear();
+
+			continue;
 		}
 
-		//
-		// Equalization, harmonics & buffer restoration
-		//
-		
-		if ((midSide & 3) == 3)
-		{
-			{
-				// Mid equalization
-				juce::dsp::AudioBlock<float> block(midBuffer);
-				juce::dsp::ProcessContextReplacing<float> context(block);
-				equalizerProcessors_[0].process(context);
-			}
+		// Neutral bands go into the sum as they are
+		for (size_t ch = 0; ch < band.getNumChannels(); ch++)
+			bandGains.setGainDecibels(k, ch, static_cast<SampleType>(gains[k]));
 
-			{
-				// Mid harmonics
-				if (parameters_.harmonicsMid[0]->get()) {
-					//juce::AudioBuffer<float> harmonicsBuffer(1, sampleCount);
-					//harmonicsBuffer.copyFrom(0, 0, midBuffer, 0, 0, sampleCount);
-
-					//juce::dsp::AudioBlock<float> block(harmonicsBuffer);
-					//juce::dsp::ProcessContextReplacing<float> context(block);
-					//convolution_.process(context);
-
-					//// Mix according to the drive value
-					//const float* harmonicsSamples{ harmonicsBuffer.getReadPointer(0) };
-
-					for (int i = 0; i < sampleCount; i++) {
-						//midSamples[0][i] = midSamples[1][i] = juce::jmap(harmonicsDrive, midSamples[0][i], harmonicsSamples[i]);
-						midSamples[0][i] = midSamples[1][i] = juce::jmap(harmonicsDrive, midSamples[0][i], testHarmonics(midSamples[0][i]));
-					}
-				}
-			}
+		if (bandGains.isNeutral(k))
+			continue;
 
-			{
-				// Side equalization
-				juce::dsp::AudioBlock<float> block(sideBuffer);
-				juce::dsp::ProcessContextReplacing<float> context(block);
-				equalizerProcessors_[1].process(context);
-			}
+		bandGains.process(k, band);
+	}
 
-			{
-				// Side harmonics
-				if (parameters_.harmonicsMid[0]->get()) {
-					//juce::AudioBuffer<float> harmonicsBuffer(2, sampleCount);
-					//harmonicsBuffer.copyFrom(0, 0, sideBuffer, 0, 0, sampleCount);
-					//harmonicsBuffer.copyFrom(1, 0, sideBuffer, 1, 0, sampleCount);
-
-					//juce::dsp::AudioBlock<float> block(harmonicsBuffer);
-					//juce::dsp::ProcessContextReplacing<float> context(block);
-					//convolution_.process(context);
-
-					//// Mix according to the drive value
-					//const float* harmonicsSamples[] { harmonicsBuffer.getReadPointer(0), harmonicsBuffer.getReadPointer(1) };
-
-					for (int i = 0; i < sampleCount; i++) {
-						for (int j = 0; j < 2; j++) {
-							//sideSamples[j][i] = juce::jmap(harmonicsDrive, sideSamples[j][i], harmonicsSamples[j][i]);
-							sideSamples[j][i] = juce::jmap(harmonicsDrive, sideSamples[j][i], testHarmonics(sideSamples[j][i]));
-						}
-					}
-				}
-			}
+	multiBand.reconstructBlock(block);
+}
 
-			// Concatenate the mid & side buffers back together
-			for (auto i = 0; i < sampleCount; i++)
-			{
-				// old way, before the decision was made to leave the side part stereo-split
-				//samples[0][i] = midSamples[i] + sideSamples[i];
-				//samples[1][i] = midSamples[i] - sideSamples[i];
-
-				// new way
-				//samples[0][i] = midSamples[i] + sideSamples[0][i];
-				//samples[1][i] = midSamples[i] + sideSamples[1][i];
-				samples[0][i] = midSamples[0][i] + sideSamples[0][i];
-				samples[1][i] = midSamples[1][i] + sideSamples[1][i];
-			}
+template<typename SampleType>
+void CossackAudioProcessor::processBandLayouts(const juce::dsp::AudioBlock<SampleType>& block, const juce::dsp::AudioBlock<SampleType>* bandOutputs)
+{
+	auto& engine = getEngine<SampleType>();
+	const bool linearPhase = parameters_.linearPhase->get();
+	const int requestedBandLayout = parameters_.bandLayout->getIndex();
+	int bandLayout = requestedBandLayout;
+
+	// A linear phase layout takes over once its filters are designed, the old one keeps going until then
+	if (bandLayout != bandLayout_ && linearPhase) {
+		bool isReady = false;
+		withMultiBandProcessor<SampleType>(bandLayout, [&](auto& multiBand) { multiBand.setLinearPhase(true); isReady = multiBand.isLinearPhase(); });
+
+		if (!isReady)
+			bandLayout = bandLayout_;
+	}
+
+	if (bandLayout != bandLayout_) {
+		// The old layout takes its gains along. Back to the one still fading out, they simply trade places.
+		if (bandLayoutFadeRemaining_ > 0 && bandLayout == fadedBandLayout_) {
+			std::swap(engine.fadedBandGains, engine.bandGains);
 		}
-		else
+		else {
+			// Don't carry over the state from whenever this layout was last used, its gains ramp from the old ones
+			withMultiBandProcessor<SampleType>(bandLayout, [](auto& multiBand) { multiBand.reset(); });
+			engine.fadedBandGains = engine.bandGains;
+		}
+
+		fadedBandLayout_ = bandLayout_;
+		bandLayout_ = bandLayout;
+		bandLayoutFadeRemaining_ = bandLayoutFadeLength_;
+	}
+
+	// Layouts out of use let go of their linear phase filters
+	for (int i = 0; i < CossackConstants::bandLayoutCount; i++) {
+		const bool isFading = bandLayoutFadeRemaining_ > 0 && i == fadedBandLayout_;
+
+		if (i != bandLayout_ && i != requestedBandLayout && !isFading)
+			withMultiBandProcessor<SampleType>(i, [](auto& multiBand) { multiBand.setLinearPhase(false); });
+	}
+
+	if (bandLayoutFadeRemaining_ == 0) {
+		withMultiBandProcessor<SampleType>(bandLayout_, [&](auto& multiBand) { processBands(multiBand, engine.bandGains, block, bandOutputs, bandOutputs != nullptr); });
+		return;
+	}
+
+	// Only the current layout goes to the band outputs
+	auto fadedOut = engine.bandLayoutFadeBuffer.getSubsetChannelBlock(0, block.getNumChannels()).getSubBlock(0, block.getNumSamples());
+	fadedOut.copyFrom(block);
+
+	withMultiBandProcessor<SampleType>(fadedBandLayout_, [&](auto& multiBand) { processBands(multiBand, engine.fadedBandGains, fadedOut, nullptr, bandOutputs != nullptr); });
+	withMultiBandProcessor<SampleType>(bandLayout_, [&](auto& multiBand) { processBands(multiBand, engine.bandGains, block, bandOutputs, bandOutputs != nullptr); });
+
+	// Linear fade from the old layout's output to the new one's
+	const auto fadeLength = juce::jmin(block.getNumSamples(), static_cast<size_t>(bandLayoutFadeRemaining_));
+	const auto start = bandLayoutFadeLength_ - bandLayoutFadeRemaining_;
+	const auto scale = static_cast<SampleType>(1) / static_cast<SampleType>(bandLayoutFadeLength_);
+
+	for (size_t ch = 0; ch < block.getNumChannels(); ch++)
+	{
+		const auto* from = fadedOut.getChannelPointer(ch);
+		auto* samples = block.getChannelPointer(ch);
+
+		for (size_t j = 0; j < fadeLength; j++)
 		{
-			if (midSide & 1)
-			{
-				{
-					// Mid equalization
-					juce::dsp::AudioBlock<float> block(midBuffer);
-					juce::dsp::ProcessContextReplacing<float> context(block);
-					equalizerProcessors_[0].process(context);
-				}
-
-				{
-					// Mid harmonics
-					if (parameters_.harmonicsMid[0]->get()) {
-						//juce::AudioBuffer<float> harmonicsBuffer(1, sampleCount);
-						//harmonicsBuffer.copyFrom(0, 0, midBuffer, 0, 0, sampleCount);
-
-						//juce::dsp::AudioBlock<float> block(harmonicsBuffer);
-						//juce::dsp::ProcessContextReplacing<float> context(block);
-						//convolution_.process(context);
-
-						//// Mix according to the drive value
-						//const float* harmonicsSamples{ harmonicsBuffer.getReadPointer(0) };
-
-						for (int i = 0; i < sampleCount; i++) {
-							//midSamples[0][i] = midSamples[1][i] = juce::jmap(harmonicsDrive, midSamples[0][i], harmonicsSamples[i]);
-							midSamples[0][i] = midSamples[1][i] = juce::jmap(harmonicsDrive, midSamples[0][i], testHarmonics(midSamples[0][i]));
-						}
-					}
-				}
-
-				// Leave only the mid buffer, ditching the side
-				//buffer.copyFrom(0, 0, midBuffer, 0, 0, sampleCount);
-				//buffer.copyFrom(1, 0, midBuffer, 0, 0, sampleCount);
-				buffer.copyFrom(0, 0, midBuffer, 0, 0, sampleCount);
-				buffer.copyFrom(1, 0, midBuffer, 1, 0, sampleCount);
-			}
-			else if (midSide & 2)
-			{
-				{
-					// Side equalization
-					juce::dsp::AudioBlock<float> block(sideBuffer);
-					juce::dsp::ProcessContextReplacing<float> context(block);
-					equalizerProcessors_[1].process(context);
-				}
-
-				{
-					// Side harmonics
-					if (parameters_.harmonicsMid[0]->get()) {
-						//juce::AudioBuffer<float> harmonicsBuffer(2, sampleCount);
-						//harmonicsBuffer.copyFrom(0, 0, sideBuffer, 0, 0, sampleCount);
-						//harmonicsBuffer.copyFrom(1, 0, sideBuffer, 1, 0, sampleCount);
-
-						//juce::dsp::AudioBlock<float> block(harmonicsBuffer);
-						//juce::dsp::ProcessContextReplacing<float> context(block);
-						//convolution_.process(context);
-
-						//// Mix according to the drive value
-						//const float* harmonicsSamples[] { harmonicsBuffer.getReadPointer(0), harmonicsBuffer.getReadPointer(1) };
-
-						for (int i = 0; i < sampleCount; i++) {
-							for (int j = 0; j < 2; j++) {
-								//sideSamples[j][i] = juce::jmap(harmonicsDrive, sideSamples[j][i], harmonicsSamples[j][i]);
-								sideSamples[j][i] = juce::jmap(harmonicsDrive, sideSamples[j][i], testHarmonics(sideSamples[j][i]));
-							}
-						}
-					}
-				}
-
-				// Leave only the side buffer, ditching the mid
-				buffer.copyFrom(0, 0, sideBuffer, 0, 0, sampleCount);
-				buffer.copyFrom(1, 0, sideBuffer, 1, 0, sampleCount);
-			}
+			const auto gain = static_cast<SampleType>(start + static_cast<int>(j) + 1) * scale;
+			samples[j] = from[j] + (samples[j] - from[j]) * gain;
 		}
 	}
-	else
+
+	bandLayoutFadeRemaining_ -= static_cast<int>(fadeLength);
+}
+
+template<typename SampleType>
+void CossackAudioProcessor::processMidSide(const juce::dsp::AudioBlock<SampleType>& block)
+{
+	static constexpr auto kernels = getMidSideKernels<SampleType>(std::make_integer_sequence<int, midSideKernelCount>());
+	static_assert(hasMidSideKernelRoundTrip());
+
+	// Mono input only has the mid
+	int routing = routeMid | routeSide;
+
+	if (block.getNumChannels() < 2 || parameters_.mid->get())
+		routing = routeMid;
+	else if (parameters_.side->get())
+		routing = routeSide;
+
+	// These change the latency, the host is told right away
+	const auto linearPhaseCuts = parameters_.linearPhaseCuts->get();
+
+	if (linearPhaseCuts != linearPhaseCuts_) {
+		resetMidSide<SampleType>();
+		linearPhaseCuts_ = linearPhaseCuts;
+		updateLatency();
+	}
+
+	auto& engine = getEngine<SampleType>();
+	const auto harmonicsAntialiasing = static_cast<HarmonicsAntialiasing>(parameters_.harmonicsAntialiasing->getIndex());
+
+	if (harmonicsAntialiasing != harmonicsAntialiasing_) {
+		if (harmonicsAntialiasing != HarmonicsAntialiasing::oversampling) {
+			for (auto& waveshaper : engine.antiderivativeWaveshapers)
+				waveshaper.setOrder(static_cast<int>(harmonicsAntialiasing));
+		}
+
+		resetMidSide<SampleType>();
+		harmonicsAntialiasing_ = harmonicsAntialiasing;
+		updateLatency();
+	}
+
+	// The antiderivatives take the place of the oversampling
+	const auto oversamplingOrder = harmonicsAntialiasing_ == HarmonicsAntialiasing::oversampling ? parameters_.harmonicsOversampling->getIndex() : 0;
+
+	if (oversamplingOrder != engine.saturationOversamplers[0].getOrder()) {
+		for (auto& oversampler : engine.saturationOversamplers)
+			oversampler.setOrder(oversamplingOrder);
+
+		updateLatency();
+	}
+
+	// The linear phase cuts always run, to keep the latency, they're flat when turned off
+	if (linearPhaseCuts_)
+		routing |= routeLinearPhaseCuts;
+	else if (parameters_.lowCut->get())
+		routing |= routeLowCut;
+
+	if (!linearPhaseCuts_ && parameters_.highCut->get())
+		routing |= routeHighCut;
+
+	const auto wasShaping = harmonics_[0] || harmonics_[1];
+
+	harmonics_[0] = parameters_.harmonicsMid[0]->get();
+	harmonics_[1] = parameters_.harmonicsSide[0]->get();
+
+	const auto isShaping = harmonics_[0] || harmonics_[1];
+
+	if (isShaping != wasShaping) {
+		// Don't carry over the antiderivatives' state from whenever they last ran
+		for (auto& waveshaper : engine.antiderivativeWaveshapers)
+			waveshaper.reset();
+
+		updateLatency();
+	}
+
+	// The oversampling runs anyway to keep its latency, the antiderivatives only with either path's harmonics on
+	if (oversamplingOrder > 0 || isShaping)
+		routing |= routeHarmonics;
+
+	// Don't carry over the state from whenever a path was last used
+	if ((routing & ~midSideRouting_ & routeMid) != 0)
+		resetPath<SampleType>(0);
+
+	if ((routing & ~midSideRouting_ & routeSide) != 0)
+		resetPath<SampleType>(1);
+
+	midSideRouting_ = routing;
+
+	(this->*kernels[getMidSideKernelIndex(routing)])(block);
+}
+
+template<typename SampleType, int Routing>
+void CossackAudioProcessor::processMidSideKernel(const juce::dsp::AudioBlock<SampleType>& block)
+{
+	constexpr bool useMid = (Routing & routeMid) != 0;
+	constexpr bool useSide = (Routing & routeSide) != 0;
+
+	auto& engine = getEngine<SampleType>();
+
+	constexpr float stereoWidth = 1.2f;
+	engine.midSide.split(block, static_cast<SampleType>(stereoWidth), useMid, useSide);
+
+	constexpr bool useLowCut = (Routing & routeLowCut) != 0;
+	constexpr bool useHighCut = (Routing & routeHighCut) != 0;
+	constexpr bool useHarmonics = (Routing & routeHarmonics) != 0;
+	constexpr bool useLinearPhaseCuts = (Routing & routeLinearPhaseCuts) != 0;
+
+	const auto harmonicsDrive = static_cast<SampleType>(parameters_.opto->get());
+
+	using Cascade = typename LowHighCutProcessor<SampleType>::Cascade;
+	using Equalizer = BiquadCascade<SampleType, CossackConstants::bandCount>;
+
+	// Cuts that aren't crossfading run in the same pass as the equalizer,
+	// the high cut only when nothing nonlinear comes in between.
+	struct Chain
+	{
+		Cascade* lowCut = nullptr;
+		Cascade* highCut = nullptr;
+	};
+
+	// Low cut, always comes first, then equalization & harmonics.
+	// The high cut finishes the chain. The join is linear, so it can run on the mid & side instead of the output.
+	const auto beginPath = [&](int n, const juce::dsp::AudioBlock<SampleType>& path)
 	{
-		// Mono input.
-		// Don't do mid/side split.
-		// Use values from mid-related controls for filtering.
-		float* samples = buffer.getWritePointer(0);
-
-		//
-		// Low cut, always comes first
-		//
-		
-		if (parameters_.lowCut->get())
-			lowCutProcessor_[0].processBlock(buffer, midiMessages);
-
-
-		//
-		// Equalization
-		//
-		
+		Chain chain;
+
+		if constexpr (useLinearPhaseCuts)
+			engine.linearPhaseLowCuts[n].process(path);
+
+		if constexpr (useLowCut)
 		{
-			juce::dsp::AudioBlock<float> block(buffer);
-			juce::dsp::ProcessContextReplacing<float> context(block);
-			equalizerProcessors_[0].process(context);
+			chain.lowCut = engine.lowCuts[n].getFusableCascade();
+
+			if (chain.lowCut == nullptr)
+				engine.lowCuts[n].process(path);
 		}
 
-		//
-		// Harmonics
-		//
+		if constexpr (useHighCut && !useHarmonics)
+			chain.highCut = engine.highCuts[n].getFusableCascade();
 
-		if (parameters_.harmonicsMid[0]->get()) {
-			//juce::AudioBuffer<float> harmonicsBuffer(1, sampleCount);
-			//harmonicsBuffer.copyFrom(0, 0, buffer, 0, 0, sampleCount);
+		return chain;
+	};
 
-			//juce::dsp::AudioBlock<float> block(harmonicsBuffer);
-			//juce::dsp::ProcessContextReplacing<float> context(block);
-			//convolution_.process(context);
+	const auto processChain = [&](int n, juce::dsp::AudioBlock<SampleType> path, const Chain& chain)
+	{
+		auto& equalizer = engine.equalizers[n];
+
+		if (chain.lowCut != nullptr && chain.highCut != nullptr)
+			chain.lowCut->processChain(path, equalizer, *chain.highCut);
+		else if (chain.lowCut != nullptr)
+			chain.lowCut->processChain(path, equalizer);
+		else if (chain.highCut != nullptr)
+			equalizer.processChain(path, *chain.highCut);
+		else
+			equalizer.process(juce::dsp::ProcessContextReplacing<SampleType>(path));
+	};
 
-			//// Mix according to the drive value
-			//const float* harmonicsSamples = harmonicsBuffer.getReadPointer(0);
+	// Both paths as the two lanes of one pass, as long as they run the same cascades
+	const auto processChainPair = [&](const juce::dsp::AudioBlock<SampleType>& mid, const juce::dsp::AudioBlock<SampleType>& side, const Chain (&chains)[2])
+	{
+#if JUCE_USE_SIMD
+		const bool hasLowCuts = chains[0].lowCut != nullptr;
+		const bool hasHighCuts = chains[0].highCut != nullptr;
+
+		if (hasLowCuts != (chains[1].lowCut != nullptr) || hasHighCuts != (chains[1].highCut != nullptr))
+			return false;
+
+		Cascade* const lowCuts[2] = { chains[0].lowCut, chains[1].lowCut };
+		Cascade* const highCuts[2] = { chains[0].highCut, chains[1].highCut };
+		Equalizer* const equalizers[2] = { &engine.equalizers[0], &engine.equalizers[1] };
+
+		if (hasLowCuts && hasHighCuts)
+			Cascade::processChainPair(mid, side, lowCuts, equalizers, highCuts);
+		else if (hasLowCuts)
+			Cascade::processChainPair(mid, side, lowCuts, equalizers);
+		else if (hasHighCuts)
+			Equalizer::processChainPair(mid, side, equalizers, highCuts);
+		else
+			Equalizer::processChainPair(mid, side, equalizers);
 
-			for (int i = 0; i < sampleCount; i++) {
-				//samples[i] = juce::jmap(harmonicsDrive, samples[i], harmonicsSamples[i]);
-				samples[i] = juce::jmap(harmonicsDrive, samples[i], testHarmonics(samples[i]));
+		return true;
+#else
+		juce::ignoreUnused(mid, side, chains);
+		return false;
+#endif
+	};
+
+	const auto endPath = [&](int n, const juce::dsp::AudioBlock<SampleType>& path, const Chain& chain)
+	{
+		if constexpr (useHarmonics) {
+			auto& oversampler = engine.saturationOversamplers[n];
+
+			// A path with its harmonics off is only delayed as much as the other one, the antiderivatives do that at no mix
+			if (harmonicsAntialiasing_ != HarmonicsAntialiasing::oversampling) {
+				engine.antiderivativeWaveshapers[n].process(path, harmonics_[n] ? harmonicsDrive : static_cast<SampleType>(0));
+			}
+			else if (harmonics_[n]) {
+				engine.waveshaper.process(oversampler.upsample(path), harmonicsDrive);
+				oversampler.downsample(path);
+			}
+			else {
+				oversampler.delay(path);
 			}
 		}
+
+		if constexpr (useHighCut)
+		{
+			if (chain.highCut == nullptr)
+				engine.highCuts[n].process(path);
+		}
+
+		if constexpr (useLinearPhaseCuts)
+			engine.linearPhaseHighCuts[n].process(path);
+	};
+
+	const auto mid = engine.midSide.getMidBlock();
+	const auto side = engine.midSide.getSideBlock();
+	Chain chains[2];
+
+	if constexpr (useMid)
+		chains[0] = beginPath(0, mid);
+
+	if constexpr (useSide)
+		chains[1] = beginPath(1, side);
+
+	if (!useMid || !useSide || !processChainPair(mid, side, chains)) {
+		if constexpr (useMid)
+			processChain(0, mid, chains[0]);
+
+		if constexpr (useSide)
+			processChain(1, side, chains[1]);
 	}
 
-	// High cut, always finishes the chain and is the same for mid & side.
-	if (parameters_.highCut->get())
-		highCutProcessor_.processBlock(buffer, midiMessages);
-#endif
+	if constexpr (useMid)
+		endPath(0, mid, chains[0]);
+
+	if constexpr (useSide)
+		endPath(1, side, chains[1]);
+
+	engine.midSide.join(block, useMid, useSide);
+}
+
+template<typename SampleType>
+void CossackAudioProcessor::resetMidSide()
+{
+	for (int n = 0; n < 2; n++)
+		resetPath<SampleType>(n);
+}
+
+template<typename SampleType>
+void CossackAudioProcessor::resetPath(int n)
+{
+	auto& engine = getEngine<SampleType>();
+
+	engine.lowCuts[n].reset();
+	engine.highCuts[n].reset();
+	engine.linearPhaseLowCuts[n].reset();
+	engine.linearPhaseHighCuts[n].reset();
+	engine.equalizers[n].reset();
+	engine.saturationOversamplers[n].reset();
+	engine.antiderivativeWaveshapers[n].reset();
+}
+
+void CossackAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+	processSamples(buffer, midiMessages);
+}
+
+void CossackAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+	processSamples(buffer, midiMessages);
+}
+
+bool CossackAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+	return true;
+}
+
+template<typename SampleType>
+void CossackAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ScopedNoDenormals noDenormals;
+    auto totalNumInputChannels  = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
+
+	// KRIGS: Same for everything
+	const int sampleCount = buffer.getNumSamples();
+
+	// In case we have more outputs than inputs, this code clears any output
+    // channels that didn't contain input data, (because these aren't
+    // guaranteed to be empty - they may contain garbage).
+    // This is here to avoid people getting screaming feedback
+    // when they first compile a plugin, but obviously you don't need to keep
+    // this code if your algorithm always overwrites all the output channels.
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear(i, 0, sampleCount);
+
+    // This is the place where you'd normally do the guts of your plugin's
+    // audio processing...
+    // Make sure to reset the state if your inner loop is processing
+    // the samples and the outer loop is handling the channels.
+    // Alternatively, you can process the samples with the channels
+    // interleaved by keeping the same state.
+
+	// KRIGS: Update parameters & their dependencies
+	updateParameters<SampleType>();
+
+	//
+	// Perform the processing
+	//
+
+	auto mainBuffer = getBusBuffer(buffer, false, 0);
+	juce::dsp::AudioBlock<SampleType> block(mainBuffer);
+
+	// Don't carry over the state from whenever this mode was last used
+	const auto equalizerMode = static_cast<EqualizerMode>(parameters_.equalizerMode->getIndex());
+
+	if (equalizerMode != equalizerMode_) {
+		if (equalizerMode == EqualizerMode::bell)
+			resetMidSide<SampleType>();
+		else
+			withMultiBandProcessor<SampleType>(bandLayout_, [](auto& multiBand) { multiBand.reset(); });
+
+		// Nothing left to fade out of
+		bandLayoutFadeRemaining_ = 0;
+		equalizerMode_ = equalizerMode;
+		updateLatency();
+	}
+
+	if (equalizerMode == EqualizerMode::bell) {
+		processMidSide(block);
+	}
+	else if (totalNumInputChannels == 2) {
+		// Enabled band outputs get written by the split directly
+		SampleType* bandChannels[CossackConstants::bandCount][2];
+		juce::dsp::AudioBlock<SampleType> bandOutputs[CossackConstants::bandCount];
+		bool hasBandOutputs = false;
+
+		for (int k = 0; k < CossackConstants::bandCount; k++) {
+			const auto* bus = getBus(false, k + 1);
+
+			if (bus == nullptr || !bus->isEnabled())
+				continue;
+
+			for (int ch = 0; ch < 2; ch++)
+				bandChannels[k][ch] = buffer.getWritePointer(bus->getChannelIndexInProcessBlockBuffer(ch));
+
+			bandOutputs[k] = juce::dsp::AudioBlock<SampleType>(bandChannels[k], 2, static_cast<size_t>(sampleCount));
+			hasBandOutputs = true;
+		}
+
+		processBandLayouts(block, hasBandOutputs ? bandOutputs : nullptr);
+	}
 }
 
 //==============================================================================
@@ -745,7 +1091,18 @@ juce::AudioProcessorValueTreeState::ParameterLayout CossackAudioProcessor::creat
 	// Low/high cut
 	layout.add(std::make_unique<juce::AudioParameterBool>("lowCut", "Low Cut", false));
 	layout.add(std::make_unique<juce::AudioParameterBool>("highCut", "High Cut", false));
-	//layout.add(std::make_unique<juce::AudioParameterFloat>("rolloffFactor", "Rolloff Factor", juce::NormalisableRange{ 5.f, 100.f, 0.1f, 0.5f }, 48.f));
+
+	// Slope of the cuts in 6 dB/oct steps, the index is the filter order minus one
+	juce::StringArray slopes;
+
+	for (int order = 1; order <= LowHighCutProcessor<float>::maximumOrder; order++)
+		slopes.add(juce::String(6 * order) + " dB/oct");
+
+	layout.add(std::make_unique<juce::AudioParameterChoice>("lowCutSlope", "Low Cut Slope", slopes, 7));
+	layout.add(std::make_unique<juce::AudioParameterChoice>("highCutSlope", "High Cut Slope", slopes, 7));
+
+	// Linear phase cuts, at the cost of the latency of their filters
+	layout.add(std::make_unique<juce::AudioParameterBool>("linearPhaseCuts", "Linear Phase Cuts", false));
 
 	for (int i = 0; i < CossackConstants::bandCount; i++)
 	{
@@ -753,7 +1110,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout CossackAudioProcessor::creat
 		for (int j = 0; j < 2; j++)
 		{
 			const juce::String index = std::to_string(j) + "_" + std::to_string(i);
-			layout.add(std::make_unique<juce::AudioParameterFloat>("equalizer" + index, "Equalizer" + index, juce::NormalisableRange{ -12.f, 12.f, 0.1f, 1.f, false }, 0.f));
+			layout.add(std::make_unique<juce::AudioParameterFloat>("equalizer" + index, "Equalizer" + index, juce::NormalisableRange{ CossackConstants::equalizerGainMinimum, CossackConstants::equalizerGainMaximum, CossackConstants::equalizerGainStep, 1.f, false }, 0.f));
 		}
 
 		// Harmonics
@@ -763,6 +1120,44 @@ juce::AudioProcessorValueTreeState::ParameterLayout CossackAudioProcessor::creat
 			layout.add(std::make_unique<juce::AudioParameterBool>("harmonicsSide" + std::to_string(i), "Harmonics Side" + std::to_string(i), false));
 	}
 
+	// Oversampling of the harmonics in the mid/side chain, the index is the power of two.
+	// Off by default, it adds its latency to the whole chain.
+	layout.add(std::make_unique<juce::AudioParameterChoice>("harmonicsOversampling", "Harmonics Oversampling", juce::StringArray{ "1x", "2x", "4x", "8x" }, 0));
+
+	// Antiderivative anti-aliasing instead of the oversampling, for zero or one sample of latency.
+	// The index is the order, see HarmonicsAntialiasing.
+	layout.add(std::make_unique<juce::AudioParameterChoice>("harmonicsAntialiasing", "Harmonics Anti-aliasing", juce::StringArray{ "Oversampling", "ADAA 1st order", "ADAA 2nd order" }, 0));
+
+	// Glide time of the equalizer to new gains in ms, 0 jumps at the next block
+	layout.add(std::make_unique<juce::AudioParameterFloat>("equalizerSmoothing", "Equalizer Smoothing", juce::NormalisableRange{ 0.f, 200.f, 1.f }, 20.f));
+
+	// Band gains of the crossover, or bell filters on the mid & side along with the cuts & harmonics.
+	// Same order as EqualizerMode.
+	layout.add(std::make_unique<juce::AudioParameterChoice>("equalizerMode", "Equalizer Mode", juce::StringArray{ "Crossover", "Bell" }, 0));
+
+	// Multi-band split
+	juce::StringArray bandLayouts;
+
+	for (const auto& bandLayout : CossackConstants::bandLayouts)
+		bandLayouts.add(juce::String(bandLayout.bandCount) + " bands");
+
+	layout.add(std::make_unique<juce::AudioParameterChoice>("bandLayout", "Band Layout", bandLayouts, 0));
+
+	// Linear phase crossovers, for the offline work where the latency doesn't matter
+	layout.add(std::make_unique<juce::AudioParameterBool>("linearPhase", "Linear Phase", false));
+
+	// Phase aligned bands, for the per-band processing that needs them
+	layout.add(std::make_unique<juce::AudioParameterBool>("immediatePhaseCorrection", "Immediate Phase Correction", false));
+
+	// Each crossover stays between the central frequencies of its bands
+	for (int i = 0; i < CossackConstants::crossoverCount; i++)
+	{
+		juce::NormalisableRange<float> range{ float(CossackConstants::bandFrequencies[i]), float(CossackConstants::bandFrequencies[i + 1]) };
+		range.setSkewForCentre(CossackConstants::crossoverFrequencies[i]);
+
+		layout.add(std::make_unique<juce::AudioParameterFloat>("crossover" + std::to_string(i), "Crossover" + std::to_string(i), range, CossackConstants::crossoverFrequencies[i]));
+	}
+
 	// Mid/side
 	layout.add(std::make_unique<juce::AudioParameterBool>("mid", "Mid", false));
 	layout.add(std::make_unique<juce::AudioParameterBool>("midSide", "Mid/Side", true));
@@ -779,31 +1174,55 @@ juce::AudioProcessorValueTreeState::ParameterLayout CossackAudioProcessor::creat
 
 void CossackAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
 {
-
+	for (int i = 0; i < 2; i++)
+	{
+		for (int j = 0; j < CossackConstants::bandCount; j++)
+		{
+			if (parameterID == parameters_.equalizers[i][j]->paramID)
+			{
+				equalizerChanged_[i][j] = true;
+				return;
+			}
+		}
+	}
 }
 
+template<typename SampleType>
 void CossackAudioProcessor::updateParameters()
 {
-	//constexpr double inverseSqrt2 = static_cast<double> (0.70710678118654752440L);
-	const double inverseSqrt2 = 1.0 / juce::MathConstants<double>::sqrt2;
-	const float Q = 2.f;
+	auto& engine = getEngine<SampleType>();
+
+	// Low/high cut, the side's low cut keeps its fixed slope
+	engine.lowCuts[0].setOrder(parameters_.lowCutSlope->getIndex() + 1);
+
+	for (auto& highCut : engine.highCuts)
+		highCut.setOrder(parameters_.highCutSlope->getIndex() + 1);
+
+	engine.linearPhaseLowCuts[0].setOrder(parameters_.lowCutSlope->getIndex() + 1);
+
+	// Harmonics
+	engine.waveshaper.setSaturation(parameters_.glue->get());
+
+	// The logistic curve, type 0 of testHarmonics()
+	for (auto& waveshaper : engine.antiderivativeWaveshapers)
+		waveshaper.setCurve(AntiderivativeWaveshaper<SampleType>::Curve::logistic, parameters_.glue->get());
+
+	for (int i = 0; i < 2; i++)
+	{
+		engine.linearPhaseLowCuts[i].setEnabled(parameters_.lowCut->get());
+		engine.linearPhaseHighCuts[i].setEnabled(parameters_.highCut->get());
+		engine.linearPhaseHighCuts[i].setOrder(parameters_.highCutSlope->getIndex() + 1);
+	}
 
 	// Mid/side
 	for (int i = 0; i < 2; i++)
 	{
-		// Band
+		engine.equalizers[i].setSmoothingTime(parameters_.equalizerSmoothing->get() / 1000.0);
+
 		for (int j = 0; j < CossackConstants::bandCount; j++)
-			equalizerGains_[i][j].setGainDecibels(parameters_.equalizers[i][j]->get());
-
-		*equalizerProcessors_[i].get<0>().state = *Coefficients::makeLowShelf(sampleRate_, CossackConstants::bandFrequencies[0], inverseSqrt2, juce::Decibels::decibelsToGain(parameters_.equalizers[i][0]->get()));
-		*equalizerProcessors_[i].get<1>().state = *Coefficients::makePeakFilter(sampleRate_, CossackConstants::bandFrequencies[1], Q, juce::Decibels::decibelsToGain(parameters_.equalizers[i][1]->get()));
-		*equalizerProcessors_[i].get<2>().state = *Coefficients::makePeakFilter(sampleRate_, CossackConstants::bandFrequencies[2], Q, juce::Decibels::decibelsToGain(parameters_.equalizers[i][2]->get()));
-		*equalizerProcessors_[i].get<3>().state = *Coefficients::makePeakFilter(sampleRate_, CossackConstants::bandFrequencies[3], Q, juce::Decibels::decibelsToGain(parameters_.equalizers[i][3]->get()));
-		*equalizerProcessors_[i].get<4>().state = *Coefficients::makePeakFilter(sampleRate_, CossackConstants::bandFrequencies[4], Q, juce::Decibels::decibelsToGain(parameters_.equalizers[i][4]->get()));
-		*equalizerProcessors_[i].get<5>().state = *Coefficients::makePeakFilter(sampleRate_, CossackConstants::bandFrequencies[5], Q, juce::Decibels::decibelsToGain(parameters_.equalizers[i][5]->get()));
-		*equalizerProcessors_[i].get<6>().state = *Coefficients::makePeakFilter(sampleRate_, CossackConstants::bandFrequencies[6], Q, juce::Decibels::decibelsToGain(parameters_.equalizers[i][6]->get()));
-		*equalizerProcessors_[i].get<7>().state = *Coefficients::makePeakFilter(sampleRate_, CossackConstants::bandFrequencies[7], Q, juce::Decibels::decibelsToGain(parameters_.equalizers[i][7]->get()));
-		*equalizerProcessors_[i].get<8>().state = *Coefficients::makePeakFilter(sampleRate_, CossackConstants::bandFrequencies[8], Q, juce::Decibels::decibelsToGain(parameters_.equalizers[i][8]->get()));
-		*equalizerProcessors_[i].get<9>().state = *Coefficients::makeHighShelf(sampleRate_, CossackConstants::bandFrequencies[9], inverseSqrt2, juce::Decibels::decibelsToGain(parameters_.equalizers[i][9]->get()));
+		{
+			if (equalizerChanged_[i][j].exchange(false))
+				engine.equalizers[i].setCoefficients(j, engine.equalizerTable.getCoefficients(j, parameters_.equalizers[i][j]->get()));
+		}
 	}
 }
@@ -9,9 +9,21 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <tuple>
+#include <utility>
 #include "Common.h"
+#include "AntiderivativeWaveshaper.h"
+#include "BandGainProcessor.h"
+#include "BiquadCascade.h"
+#include "EqualizerCoefficientTable.h"
+#include "MidSideProcessor.h"
+#include "LinearPhaseCutProcessor.h"
 #include "LowHighCutProcessor.h"
 #include "MultiBandProcessor.h"
+#include "SaturationOversampler.h"
+#include "WaveshaperTable.h"
 
 //==============================================================================
 /**
@@ -34,6 +46,9 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+
+	bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -61,13 +76,202 @@ public:
 	juce::AudioProcessorValueTreeState& getValueTreeState();
 
 private:
+	// Main stereo in/out, followed by an optional stereo output per band
+	static BusesProperties createBusesProperties();
+
 	// Creates parameter list for the APVTS
 	static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+	// Flags the equalizer bands for the redesign, may come from any thread
 	void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+	// Looks up the new coefficients of the flagged equalizer bands, they glide there over the smoothing time.
+	// Also passes the slopes on to the cuts.
+	template<typename SampleType>
 	void updateParameters();
 
-	float testHarmonics(float sample);
+	// What the equalizer gains drive, the index of the "equalizerMode" parameter
+	enum class EqualizerMode
+	{
+		// Gains of the multi-band split, on the left & right channels
+		crossover,
+		// Bell filters on the mid & side, along with the cuts & the harmonics
+		bell
+	};
+
+	// How the harmonics keep their aliasing down, the index of the "harmonicsAntialiasing" parameter
+	enum class HarmonicsAntialiasing
+	{
+		// Waveshaper table at the rate of "harmonicsOversampling"
+		oversampling,
+		// Antiderivative waveshapers at the host rate, no oversampling.
+		// They only run while the harmonics are on, shaping both paths alike so they stay aligned.
+		firstOrderAntiderivative,
+		secondOrderAntiderivative
+	};
+
+	// Everything the processing chain needs for one sample type.
+	// Only the one matching the host's precision gets prepared.
+	template<typename SampleType>
+	struct Engine
+	{
+		// Multi-band splitters, one per entry of CossackConstants::bandLayouts
+		std::tuple<MultiBandProcessor<SampleType, 10>, MultiBandProcessor<SampleType, 5>, MultiBandProcessor<SampleType, 4>, MultiBandProcessor<SampleType, 3>> multiBandProcessors;
+
+		// Equalizer gains of the split bands
+		BandGainProcessor<SampleType> bandGains;
+
+		// Gains & the output of the band layout being faded out, maximum block size long per channel
+		BandGainProcessor<SampleType> fadedBandGains;
+		juce::HeapBlock<char> bandLayoutFadeMemory;
+		juce::dsp::AudioBlock<SampleType> bandLayoutFadeBuffer;
+
+		// Mid/side split & the bell equalizers of the mid & side, mono each
+		MidSideProcessor<SampleType> midSide;
+		BiquadCascade<SampleType, CossackConstants::bandCount> equalizers[2];
+
+		// Low & high cuts of the mid & side, mono each
+		LowHighCutProcessor<SampleType> lowCuts[2]{
+			{ 30, 8 },
+			{ 100, 2 }
+		};
+		LowHighCutProcessor<SampleType> highCuts[2]{
+			{ 20000, 8, true },
+			{ 20000, 8, true }
+		};
+
+		// Same, linear phase. Mid & side need the same filter lengths to stay aligned.
+		LinearPhaseCutProcessor<SampleType> linearPhaseLowCuts[2]{
+			{ 30.f, 8, false, 0.25 },
+			{ 100.f, 2, false, 0.25 }
+		};
+		LinearPhaseCutProcessor<SampleType> linearPhaseHighCuts[2]{
+			{ 20000.f, 8, true, 0.02 },
+			{ 20000.f, 8, true, 0.02 }
+		};
+
+		// Around the harmonics of the mid & side
+		SaturationOversampler<SampleType> saturationOversamplers[2];
+
+		// The harmonics curve, shared by the mid & side
+		WaveshaperTable<SampleType> waveshaper{ &CossackAudioProcessor::testHarmonics };
+
+		// Same curve with antiderivative anti-aliasing, instead of the oversampling & the table.
+		// Mid & side each, it has a state.
+		AntiderivativeWaveshaper<SampleType> antiderivativeWaveshapers[2];
+
+		// Designed for the current sample rate in prepareToPlay()
+		EqualizerCoefficientTable<SampleType> equalizerTable;
+	};
+
+	template<typename SampleType>
+	Engine<SampleType>& getEngine();
+
+	template<typename SampleType>
+	void prepareEngine(Engine<SampleType>& engine, const juce::dsp::ProcessSpec& spec);
+
+	// Both processBlock() overloads end up here
+	template<typename SampleType>
+	void processSamples(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
+
+	// Run the splitter of the current band layout with the band processing in between
+	template<typename SampleType, typename Function>
+	void withMultiBandProcessor(int bandLayout, Function&& function);
+
+	// Report the delay of the current splitter to the host if it changed
+	void updateLatency();
+
+	// Split & reconstruct the block with the current band layout,
+	// along with the one faded out of for a while after a change
+	template<typename SampleType>
+	void processBandLayouts(const juce::dsp::AudioBlock<SampleType>& block, const juce::dsp::AudioBlock<SampleType>* bandOutputs);
+
+	// bandOutputs as in MultiBandProcessor::splitBlock().
+	// The bands are aligned when some are sent out, even if this layout doesn't write them.
+	template<typename SampleType, typename MultiBand>
+	void processBands(MultiBand& multiBand, BandGainProcessor<SampleType>& bandGains, const juce::dsp::AudioBlock<SampleType>& block, const juce::dsp::AudioBlock<SampleType>* bandOutputs, bool hasBandOutputs);
+
+	// Mid/side chain of the bell equalizer mode, on the main bus.
+	// Picks the kernel for the block's routing.
+	template<typename SampleType>
+	void processMidSide(const juce::dsp::AudioBlock<SampleType>& block);
+
+	// Routing of the mid/side chain, a bitfield fixed for the whole block.
+	// The mid, the side or both, never neither.
+	enum MidSideRouting
+	{
+		routeMid = 1,
+		routeSide = 2,
+		routeLowCut = 4,
+		routeHighCut = 8,
+		// The saturation stage, shaping the paths with their harmonics on & delaying the others
+		routeHarmonics = 16,
+		// Both linear phase cuts, instead of the other two
+		routeLinearPhaseCuts = 32,
+		midSideRoutingCount = 64
+	};
+
+	// The mid/side chain with everything not in the routing compiled out
+	template<typename SampleType, int Routing>
+	void processMidSideKernel(const juce::dsp::AudioBlock<SampleType>& block);
+
+	template<typename SampleType>
+	using MidSideKernel = void (CossackAudioProcessor::*)(const juce::dsp::AudioBlock<SampleType>&);
+
+	// The kernels are indexed by the path choice & the stages as separate dimensions,
+	// so that routings without either path don't get one. The linear phase cuts replace the other two,
+	// the stages are either the IIR cuts & the harmonics or the linear phase cuts & the harmonics.
+	static constexpr int pathChoiceCount = 3;
+	static constexpr int iirStageRoutingCount = 8;
+	static constexpr int stageRoutingCount = iirStageRoutingCount + 2;
+	static constexpr int midSideKernelCount = pathChoiceCount * stageRoutingCount;
+
+	static constexpr int getMidSideKernelIndex(int routing)
+	{
+		const int harmonics = (routing & routeHarmonics) != 0 ? 1 : 0;
+		const int stages = (routing & routeLinearPhaseCuts) != 0
+			? iirStageRoutingCount + harmonics
+			: (routing & (routeLowCut | routeHighCut)) / routeLowCut + harmonics * 4;
+
+		return ((routing & (routeMid | routeSide)) - 1) * stageRoutingCount + stages;
+	}
+
+	static constexpr int getMidSideRouting(int kernelIndex)
+	{
+		const int stages = kernelIndex % stageRoutingCount;
+		const int harmonics = stages >= iirStageRoutingCount ? stages - iirStageRoutingCount : stages / 4;
+		const int cuts = stages >= iirStageRoutingCount ? routeLinearPhaseCuts : (stages % 4) * routeLowCut;
+
+		return (kernelIndex / stageRoutingCount + 1) | cuts | harmonics * routeHarmonics;
+	}
+
+	// Every kernel's routing maps back to it
+	static constexpr bool hasMidSideKernelRoundTrip()
+	{
+		for (int i = 0; i < midSideKernelCount; i++) {
+			if (getMidSideKernelIndex(getMidSideRouting(i)) != i)
+				return false;
+		}
+
+		return true;
+	}
+
+	// One kernel per reachable routing, see getMidSideKernelIndex()
+	template<typename SampleType, int... Indices>
+	static constexpr std::array<MidSideKernel<SampleType>, sizeof...(Indices)> getMidSideKernels(std::integer_sequence<int, Indices...>)
+	{
+		return { &CossackAudioProcessor::processMidSideKernel<SampleType, getMidSideRouting(Indices)>... };
+	}
+
+	template<typename SampleType>
+	void resetMidSide();
+
+	// Mid or side path only
+	template<typename SampleType>
+	void resetPath(int n);
+
+	// The harmonics curve at the given "glue", baked into the waveshaper tables
+	static float testHarmonics(float sample, float saturation);
 
 	juce::AudioProcessorValueTreeState valueTreeState_;
 
@@ -79,6 +283,9 @@ private:
 		// Low/high cut
 		juce::AudioParameterBool* lowCut;
 		juce::AudioParameterBool* highCut;
+		juce::AudioParameterChoice* lowCutSlope;
+		juce::AudioParameterChoice* highCutSlope;
+		juce::AudioParameterBool* linearPhaseCuts;
 
 		// Mid/side
 		juce::AudioParameterBool* mid;
@@ -89,29 +296,61 @@ private:
 
 		// Equalizer
 		juce::AudioParameterFloat* equalizers[2][CossackConstants::bandCount];
+		juce::AudioParameterFloat* equalizerSmoothing;
+		juce::AudioParameterChoice* equalizerMode;
+
+		// Multi-band split
+		juce::AudioParameterChoice* bandLayout;
+		juce::AudioParameterFloat* crossovers[CossackConstants::crossoverCount];
+		juce::AudioParameterBool* linearPhase;
+		juce::AudioParameterBool* immediatePhaseCorrection;
 
 		// Harmonics
 		juce::AudioParameterBool* harmonicsMid[10];
 		juce::AudioParameterBool* harmonicsSide[8];
+		juce::AudioParameterChoice* harmonicsOversampling;
+		juce::AudioParameterChoice* harmonicsAntialiasing;
 
 		// Compressors
 		juce::AudioParameterFloat* opto;
 		juce::AudioParameterFloat* glue;
 	} parameters_;
 
-	LowHighCutProcessor lowCutProcessor_[2];
-	LowHighCutProcessor highCutProcessor_;
+	Engine<float> floatEngine_;
+	Engine<double> doubleEngine_;
+	static_assert(std::tuple_size_v<decltype(floatEngine_.multiBandProcessors)> == CossackConstants::bandLayoutCount);
+
+	// Layout used by the last block, the splitter is reset when it changes
+	int bandLayout_;
+
+	// Layout faded out of after a change, it keeps running until the fade is done
+	static constexpr double bandLayoutFadeTime = 0.02;
+	int fadedBandLayout_;
+	int bandLayoutFadeLength_;
+	int bandLayoutFadeRemaining_;
+
+	// Same for the equalizer mode
+	EqualizerMode equalizerMode_;
+
+	// Same for the linear phase cuts, they set the latency of the mid/side chain
+	bool linearPhaseCuts_;
+
+	// Same for the anti-aliasing of the harmonics
+	HarmonicsAntialiasing harmonicsAntialiasing_;
 
-	MultiBandProcessor<float> multiBandProcessor_;
+	// Same for the harmonics switches of the mid & side,
+	// the second order antiderivatives only add their sample of latency while either is on
+	bool harmonics_[2];
 
-	juce::dsp::Gain<float> equalizerGains_[2][CossackConstants::bandCount];
+	// Routing of the last mid/side block, paths coming back are reset
+	int midSideRouting_;
 
-	// FIXME: temporary
-	using Filter = juce::dsp::IIR::Filter<float>;
-	using Coefficients = juce::dsp::IIR::Coefficients<float>;
-	using Duplicator = juce::dsp::ProcessorDuplicator<Filter, Coefficients>;
+	// Redesigns the splitters' & the cuts' linear phase filters.
+	// Declared after them, so that the thread stops before they're gone.
+	BackgroundDesigner backgroundDesigner_;
 
-	juce::dsp::ProcessorChain<Duplicator, Duplicator, Duplicator, Duplicator, Duplicator, Duplicator, Duplicator, Duplicator, Duplicator, Duplicator> equalizerProcessors_[2];
+	// Set by parameterChanged(), or when the sample rate changes
+	std::atomic<bool> equalizerChanged_[2][CossackConstants::bandCount];
 
 	juce::dsp::Convolution convolution_;
 
@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+    SaturationOversampler.cpp
+    Created: 18 Oct 2026 2:24:09am
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#include "SaturationOversampler.h"
+
+template<typename SampleType>
+SaturationOversampler<SampleType>::SaturationOversampler() :
+	latencies_{},
+	order_(0),
+	delayCapacity_(0),
+	delayPosition_(0),
+	isShaping_(false),
+	isFading_(false),
+	channelCount_(0)
+{
+}
+
+template<typename SampleType>
+void SaturationOversampler<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+{
+	channelCount_ = spec.numChannels;
+
+	int maximumLatency = 0;
+
+	for (int i = 0; i < maximumOrder; i++)
+	{
+		oversampling_[i] = std::make_unique<Oversampling>(channelCount_, static_cast<size_t>(i + 1), Oversampling::filterHalfBandFIREquiripple, true, true);
+		oversampling_[i]->initProcessing(spec.maximumBlockSize);
+
+		latencies_[i] = juce::roundToInt(oversampling_[i]->getLatencyInSamples());
+		maximumLatency = juce::jmax(maximumLatency, latencies_[i]);
+	}
+
+	delayCapacity_ = static_cast<size_t>(maximumLatency);
+	delayBuffer_.assign(channelCount_ * delayCapacity_, static_cast<SampleType>(0));
+
+	fadeBuffer_ = juce::dsp::AudioBlock<SampleType>(fadeMemory_, channelCount_, spec.maximumBlockSize);
+
+	reset();
+}
+
+template<typename SampleType>
+void SaturationOversampler<SampleType>::reset()
+{
+	for (auto& oversampling : oversampling_)
+		if (oversampling != nullptr)
+			oversampling->reset();
+
+	std::fill(delayBuffer_.begin(), delayBuffer_.end(), static_cast<SampleType>(0));
+	delayPosition_ = 0;
+	isFading_ = false;
+}
+
+template<typename SampleType>
+void SaturationOversampler<SampleType>::setOrder(int order)
+{
+	jassert(order >= 0 && order <= maximumOrder);
+
+	if (order != order_)
+	{
+		order_ = order;
+		reset();
+	}
+}
+
+template<typename SampleType>
+int SaturationOversampler<SampleType>::getOrder() const
+{
+	return order_;
+}
+
+template<typename SampleType>
+int SaturationOversampler<SampleType>::getLatency() const
+{
+	return order_ == 0 ? 0 : latencies_[order_ - 1];
+}
+
+template<typename SampleType>
+juce::dsp::AudioBlock<SampleType> SaturationOversampler<SampleType>::upsample(const juce::dsp::AudioBlock<SampleType>& block)
+{
+	if (order_ == 0)
+		return block;
+
+	isFading_ = !isShaping_;
+	isShaping_ = true;
+
+	if (isFading_)
+	{
+		// Primed before the delay line moves on, the fade starts from what it would have put out
+		prime();
+
+		auto fade = fadeBuffer_.getSubBlock(0, block.getNumSamples());
+		fade.copyFrom(block);
+		updateDelay(fade, true);
+	}
+	else
+	{
+		updateDelay(block, false);
+	}
+
+	return oversampling_[order_ - 1]->processSamplesUp(block);
+}
+
+template<typename SampleType>
+void SaturationOversampler<SampleType>::downsample(const juce::dsp::AudioBlock<SampleType>& block)
+{
+	if (order_ == 0)
+		return;
+
+	auto ioBlock = block;
+	oversampling_[order_ - 1]->processSamplesDown(ioBlock);
+
+	if (!isFading_)
+		return;
+
+	// From the delayed samples to the shaped ones, linear over the block
+	const auto numSamples = block.getNumSamples();
+	const auto scale = static_cast<SampleType>(1) / static_cast<SampleType>(numSamples);
+
+	for (size_t ch = 0; ch < channelCount_; ch++)
+	{
+		const auto* from = fadeBuffer_.getChannelPointer(ch);
+		auto* samples = block.getChannelPointer(ch);
+
+		for (size_t j = 0; j < numSamples; j++)
+			samples[j] = from[j] + (samples[j] - from[j]) * static_cast<SampleType>(j + 1) * scale;
+	}
+
+	isFading_ = false;
+}
+
+template<typename SampleType>
+void SaturationOversampler<SampleType>::delay(const juce::dsp::AudioBlock<SampleType>& block)
+{
+	isShaping_ = false;
+
+	if (order_ == 0)
+		return;
+
+	updateDelay(block, true);
+}
+
+template<typename SampleType>
+void SaturationOversampler<SampleType>::prime()
+{
+	auto& oversampling = *oversampling_[order_ - 1];
+	oversampling.reset();
+
+	// Oldest first, in pieces of at most the block size
+	const auto length = static_cast<size_t>(getLatency());
+	const auto maximumBlockSize = fadeBuffer_.getNumSamples();
+
+	for (size_t start = 0; start < length; start += maximumBlockSize)
+	{
+		const auto numSamples = juce::jmin(maximumBlockSize, length - start);
+		auto scratch = fadeBuffer_.getSubBlock(0, numSamples);
+
+		for (size_t ch = 0; ch < channelCount_; ch++)
+		{
+			const auto* buffer = delayBuffer_.data() + ch * delayCapacity_;
+			auto* samples = scratch.getChannelPointer(ch);
+
+			for (size_t j = 0; j < numSamples; j++)
+				samples[j] = buffer[(delayPosition_ + start + j) % length];
+		}
+
+		oversampling.processSamplesUp(scratch);
+		oversampling.processSamplesDown(scratch);
+	}
+}
+
+template<typename SampleType>
+void SaturationOversampler<SampleType>::updateDelay(const juce::dsp::AudioBlock<SampleType>& block, bool replace)
+{
+	jassert(block.getNumChannels() == channelCount_);
+
+	const auto length = static_cast<size_t>(getLatency());
+	const auto numSamples = block.getNumSamples();
+	auto position = delayPosition_;
+
+	if (length == 0)
+		return;
+
+	for (size_t ch = 0; ch < channelCount_; ch++)
+	{
+		auto* buffer = delayBuffer_.data() + ch * delayCapacity_;
+		auto* samples = block.getChannelPointer(ch);
+		position = delayPosition_;
+
+		for (size_t j = 0; j < numSamples; j++)
+		{
+			const auto delayed = buffer[position];
+			buffer[position] = samples[j];
+
+			if (replace)
+				samples[j] = delayed;
+
+			if (++position == length)
+				position = 0;
+		}
+	}
+
+	delayPosition_ = position;
+}
+
+template class SaturationOversampler<float>;
+template class SaturationOversampler<double>;
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    SaturationOversampler.h
+    Created: 18 Oct 2026 2:24:09am
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+
+//
+// Oversampling around the saturation of one mid/side path, 2x, 4x or 8x,
+// so that the harmonics above Nyquist are filtered out instead of folding back.
+//
+// The half-band filters are linear phase with an integer latency. A path that has its harmonics
+// turned off only gets delayed by the same amount, so the mid & side stay aligned
+// & the latency depends on the factor alone. Turned back on, the oversampling is primed
+// with the samples still in the delay line & faded in over the block.
+//
+template<typename SampleType>
+class SaturationOversampler
+{
+public:
+	static constexpr int maximumOrder = 3;
+
+	SaturationOversampler();
+
+	// Allocates the oversampling of all the factors up front
+	void prepare(const juce::dsp::ProcessSpec& spec);
+
+	void reset();
+
+	// Factor of 2^order, 0 shapes at the host rate with no latency. Resets when it changes.
+	void setOrder(int order);
+	int getOrder() const;
+
+	int getLatency() const;
+
+	// The block at the oversampled rate, the same block at order 0.
+	// Shape it & then bring it back down with downsample().
+	juce::dsp::AudioBlock<SampleType> upsample(const juce::dsp::AudioBlock<SampleType>& block);
+	void downsample(const juce::dsp::AudioBlock<SampleType>& block);
+
+	// In place of the above, when the harmonics are off. Only the delay line runs.
+	void delay(const juce::dsp::AudioBlock<SampleType>& block);
+
+private:
+	using Oversampling = juce::dsp::Oversampling<SampleType>;
+
+	// Feed the input into the delay line, replacing it with the delayed samples if asked to
+	void updateDelay(const juce::dsp::AudioBlock<SampleType>& block, bool replace);
+
+	// Run what's in the delay line through the reset oversampling, so it doesn't start from silence
+	void prime();
+
+	std::unique_ptr<Oversampling> oversampling_[maximumOrder];
+	int latencies_[maximumOrder];
+	int order_;
+
+	// Fed all the time, so that the harmonics can be turned off without a gap
+	// & the oversampling primed when they're turned back on
+	std::vector<SampleType> delayBuffer_;
+	size_t delayCapacity_;
+	size_t delayPosition_;
+
+	// Whether the last block was upsampled, & the first one since is being faded in
+	bool isShaping_;
+	bool isFading_;
+
+	// The delayed samples faded from, also the priming's scratch, maximum block size long per channel
+	juce::HeapBlock<char> fadeMemory_;
+	juce::dsp::AudioBlock<SampleType> fadeBuffer_;
+
+	size_t channelCount_;
+};
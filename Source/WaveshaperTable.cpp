@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    WaveshaperTable.cpp
+    Created: 18 Oct 2026 3:05:47am
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#include "WaveshaperTable.h"
+
+template<typename SampleType>
+WaveshaperTable<SampleType>::WaveshaperTable(Curve curve) :
+	curve_(curve),
+	saturation_(0.f),
+	bakedSaturation_(-1.f),
+	activeTable_(0),
+	ready_(false),
+	isPrepared_(false)
+{
+	jassert(curve_ != nullptr);
+
+	for (auto& table : tables_)
+		table.assign(tableSize + 1, static_cast<SampleType>(0));
+}
+
+template<typename SampleType>
+void WaveshaperTable<SampleType>::prepare(float saturation)
+{
+	const juce::ScopedLock lock(designLock_);
+
+	// Bake straight into the active table, nothing is pending after this
+	saturation_ = saturation;
+	activeTable_ = 0;
+	ready_ = false;
+	bake(activeTable_, saturation);
+
+	isPrepared_ = true;
+}
+
+template<typename SampleType>
+void WaveshaperTable<SampleType>::process(const juce::dsp::AudioBlock<SampleType>& block, SampleType mix)
+{
+	// Pick up the new table, if any
+	if (ready_.load(std::memory_order_acquire))
+	{
+		activeTable_ = 1 - activeTable_;
+		ready_.store(false, std::memory_order_release);
+	}
+
+	const auto* table = tables_[activeTable_].data();
+
+	// Input to table position, the last point is only ever interpolated towards
+	const auto scale = static_cast<SampleType>(tableSize) / static_cast<SampleType>(2.f * inputRange);
+	const auto offset = static_cast<SampleType>(inputRange) * scale;
+	const auto maximumPosition = static_cast<SampleType>(tableSize) - static_cast<SampleType>(0.0001);
+
+	for (size_t ch = 0; ch < block.getNumChannels(); ch++)
+	{
+		auto* samples = block.getChannelPointer(ch);
+
+		for (size_t i = 0; i < block.getNumSamples(); i++)
+		{
+			const auto x = samples[i];
+			const auto position = juce::jlimit(static_cast<SampleType>(0), maximumPosition, x * scale + offset);
+			const auto index = static_cast<int>(position);
+			const auto fraction = position - static_cast<SampleType>(index);
+
+			const auto shaped = table[index] + (table[index + 1] - table[index]) * fraction;
+
+			samples[i] = x + (shaped - x) * mix;
+		}
+	}
+}
+
+template<typename SampleType>
+void WaveshaperTable<SampleType>::setSaturation(float saturation)
+{
+	saturation_ = saturation;
+}
+
+template<typename SampleType>
+void WaveshaperTable<SampleType>::designInBackground()
+{
+	const juce::ScopedTryLock lock(designLock_);
+
+	// Not prepared yet, or the last table hasn't been picked up
+	if (!lock.isLocked() || !isPrepared_ || ready_.load(std::memory_order_acquire))
+		return;
+
+	const auto saturation = saturation_.load();
+
+	if (saturation == bakedSaturation_)
+		return;
+
+	bake(1 - activeTable_, saturation);
+	ready_.store(true, std::memory_order_release);
+}
+
+template<typename SampleType>
+void WaveshaperTable<SampleType>::bake(int table, float saturation)
+{
+	auto& points = tables_[table];
+
+	for (int n = 0; n <= tableSize; n++)
+	{
+		const auto x = -inputRange + 2.f * inputRange * static_cast<float>(n) / static_cast<float>(tableSize);
+		points[n] = static_cast<SampleType>(curve_(x, saturation));
+	}
+
+	bakedSaturation_ = saturation;
+}
+
+template class WaveshaperTable<float>;
+template class WaveshaperTable<double>;
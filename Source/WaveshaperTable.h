@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    WaveshaperTable.h
+    Created: 18 Oct 2026 3:05:47am
+    Author:  KOT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <vector>
+#include "BackgroundDesigner.h"
+
+//
+// Waveshaper curve baked into a lookup table & read with linear interpolation,
+// so that the transcendentals of the curve aren't evaluated per sample.
+//
+// The table covers [-inputRange, inputRange], the input past it is clamped to its ends.
+// A new saturation is baked on the BackgroundDesigner thread & swapped in at the start of a block.
+//
+template<typename SampleType>
+class WaveshaperTable : public BackgroundDesigner::Client
+{
+public:
+	// Shape of the input sample at the given saturation, 0..1
+	using Curve = float (*)(float sample, float saturation);
+
+	static constexpr int tableSize = 4096;
+	static constexpr float inputRange = 8.f;
+
+	explicit WaveshaperTable(Curve curve);
+
+	// Bakes the table for the given saturation right away, it's the current one from then on
+	void prepare(float saturation);
+
+	// Mix between the dry & the shaped samples, 0..1
+	void process(const juce::dsp::AudioBlock<SampleType>& block, SampleType mix);
+
+	// Safe to call from the audio thread, the table follows once baked
+	void setSaturation(float saturation);
+
+	void designInBackground() override;
+
+private:
+	// Bake the curve into the given table
+	void bake(int table, float saturation);
+
+	// Guards the baking against prepare()
+	juce::CriticalSection designLock_;
+
+	const Curve curve_;
+
+	// Requested by the audio thread & the one the tables were last baked for
+	std::atomic<float> saturation_;
+	float bakedSaturation_;
+
+	// tableSize + 1 points each, double buffered.
+	// The designer only writes the inactive one, and only while ready_ isn't set.
+	std::vector<SampleType> tables_[2];
+	int activeTable_;
+	std::atomic<bool> ready_;
+	bool isPrepared_;
+};